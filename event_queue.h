@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// --- LOCK-FREE SPSC QUEUE ---
+// One producer, one consumer (e.g. main loop -> audio callback). N must be a
+// power of two; one slot is kept free to tell full from empty.
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    bool Push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t next = (h + 1) & (N - 1);
+        if (next == tail.load(std::memory_order_acquire)) return false; // Full
+        items[h] = item;
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool Peek(T& item) const {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        item = items[t];
+        return true;
+    }
+
+    bool Pop(T& item) {
+        if (!Peek(item)) return false;
+        tail.store((tail.load(std::memory_order_relaxed) + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    bool IsEmpty() const {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[N];
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+};
@@ -1,24 +1,48 @@
 #include "hw.h"
 
-void Hardware::Init()
+void Hardware::Init(float scan_rate)
 {
     seed.Init();
-    seed.SetAudioBlockSize(4);
+    seed.SetAudioBlockSize(48); // Controls are sample-accurate via ControlEvent
     sample_rate = seed.AudioSampleRate();
 
-    // ADC: Pot on Pin 15
+    // ADC: Pot on Pin 15, DMA sampled with hardware oversampling
     AdcChannelConfig adc_config;
     adc_config.InitSingle(seed.GetPin(15));
-    seed.adc.Init(&adc_config, 1);
+    seed.adc.Init(&adc_config, 1, AdcHandle::OVS_32);
     seed.adc.Start();
 
-    // Init Pot with flip=true based on your snippet
-    // Note: ensure your libDaisy version supports the 'flip' boolean arg in Init
-    pot.Init(seed.adc.GetPtr(0), seed.AudioCallbackRate(), true);
+    // Encoder: Pin 1 (A), Pin 28 (B), Pin 2 (Click) - active low
+    enc_a.Init(seed.GetPin(1), GPIO::Mode::INPUT, GPIO::Pull::PULLUP);
+    enc_b.Init(seed.GetPin(28), GPIO::Mode::INPUT, GPIO::Pull::PULLUP);
+    enc_click.Init(seed.GetPin(2), GPIO::Mode::INPUT, GPIO::Pull::PULLUP);
 
-    // Encoder: Pin 1 (A), Pin 28 (B), Pin 2 (Click)
-    encoder.Init(seed.GetPin(1), seed.GetPin(28), seed.GetPin(2), seed.AudioCallbackRate());
+    // Button: Pin 18 - active low
+    button.Init(seed.GetPin(18), GPIO::Mode::INPUT, GPIO::Pull::PULLUP);
 
-    // Button: Pin 18
-    button.Init(seed.GetPin(18), seed.AudioCallbackRate());
-}
\ No newline at end of file
+    input.Init(scan_rate);
+
+    // Scan timer: TIM5 runs at the lowest interrupt priority, below audio DMA
+    TimerHandle::Config tim_cfg;
+    tim_cfg.periph     = TimerHandle::Config::Peripheral::TIM_5;
+    tim_cfg.dir        = TimerHandle::Config::CounterDir::UP;
+    tim_cfg.enable_irq = true;
+    tim_cfg.period     = (uint32_t)(System::GetPClk2Freq() / scan_rate);
+    scan_timer.Init(tim_cfg);
+    scan_timer.SetCallback(ScanCallback, this);
+    scan_timer.Start();
+}
+
+void Hardware::ScanCallback(void* data)
+{
+    Hardware* hw = static_cast<Hardware*>(data);
+
+    RawInputs raw;
+    raw.enc_a     = !hw->enc_a.Read();
+    raw.enc_b     = !hw->enc_b.Read();
+    raw.enc_click = !hw->enc_click.Read();
+    raw.button    = !hw->button.Read();
+    raw.pot       = 1.0f - hw->seed.adc.GetFloat(0); // Flipped, as before
+
+    hw->input.Scan(raw, System::GetNow(), System::GetTick());
+}
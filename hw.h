@@ -1,5 +1,6 @@
 #pragma once
 #include "daisy_seed.h"
+#include "input.h"
 
 using namespace daisy;
 
@@ -8,13 +9,17 @@ public:
     // Core Seed Object
     DaisySeed seed;
 
-    // Components
-    Encoder encoder;
-    Switch button;
-    AnalogControl pot;
+    // Debounced/filtered controls, scanned from a timer (not the audio callback)
+    InputScanner input;
 
     // Helper variable used in your snippet
     float sample_rate;
 
-    void Init();
-};
\ No newline at end of file
+    void Init(float scan_rate = 1000.0f);
+
+private:
+    GPIO enc_a, enc_b, enc_click, button;
+    TimerHandle scan_timer;
+
+    static void ScanCallback(void* data);
+};
@@ -0,0 +1,83 @@
+#include "input.h"
+#include <cmath>
+
+void InputScanner::Init(float scan_rate)
+{
+    quad_a = quad_b = 0xff;
+    for (int t = 0; t < IN_EVENT_TYPES; t++) {
+        pending[t] = 0;
+        pending_tick[t] = 0;
+    }
+
+    enc_state = 0x00;
+    btn_state = 0x00;
+    enc_down = false;
+    btn_down = false;
+    last_btn_time = 0u - BUTTON_LOCKOUT_MS - 1; // First press is never locked out
+
+    // One-pole smoothing on the pot, time constant POT_SMOOTH_SEC
+    pot_coeff = 1.0f - expf(-1.0f / (POT_SMOOTH_SEC * scan_rate));
+    pot_filtered = 0.0f;
+    pot_published = 0.0f;
+    pot_tick = 0;
+    pot_primed = false;
+}
+
+void InputScanner::Publish(InputEventType type, int32_t value, uint32_t tick)
+{
+    if (pending[type] == 0) pending_tick[type] = tick;
+    pending[type] += value;
+}
+
+void InputScanner::Flush()
+{
+    for (int t = 0; t < IN_EVENT_TYPES; t++) {
+        if (pending[t] == 0) continue;
+        InputEvent ev;
+        ev.type = (InputEventType)t;
+        ev.value = pending[t];
+        ev.pot = pot_published;
+        ev.tick = pending_tick[t];
+        // Queue full: the main loop is stalled, keep counting and retry
+        if (!events.Push(ev)) return;
+        pending[t] = 0;
+    }
+}
+
+void InputScanner::Scan(const RawInputs& raw, uint32_t now_ms, uint32_t tick)
+{
+    // 1. Encoder quadrature (same decoding as daisy::Encoder)
+    quad_a = (quad_a << 1) | (raw.enc_a ? 0 : 1);
+    quad_b = (quad_b << 1) | (raw.enc_b ? 0 : 1);
+    if ((quad_a & 0x03) == 0x02 && (quad_b & 0x03) == 0x00) Publish(IN_ENC_TURN, 1, tick);
+    else if ((quad_b & 0x03) == 0x02 && (quad_a & 0x03) == 0x00) Publish(IN_ENC_TURN, -1, tick);
+
+    // 2. Switches: shift-register debounce (8 stable scans). Edges are taken
+    // against the debounced state, so a glitch shorter than the window
+    // produces neither a press nor a release.
+    enc_state = (enc_state << 1) | (raw.enc_click ? 1 : 0);
+    if (!enc_down && enc_state == 0xff) { enc_down = true; Publish(IN_ENC_PRESS, 1, tick); }
+    if (enc_down && enc_state == 0x00) { enc_down = false; Publish(IN_ENC_RELEASE, 1, tick); }
+
+    btn_state = (btn_state << 1) | (raw.button ? 1 : 0);
+    if (!btn_down && btn_state == 0xff) {
+        btn_down = true;
+        if (now_ms - last_btn_time > BUTTON_LOCKOUT_MS) {
+            Publish(IN_BTN_PRESS, 1, tick);
+            last_btn_time = now_ms;
+        }
+    }
+    if (btn_down && btn_state == 0x00) { btn_down = false; Publish(IN_BTN_RELEASE, 1, tick); }
+
+    // 3. Pot: smooth, then only publish moves larger than the hysteresis.
+    // Not queued: the main loop only ever wants the latest value.
+    if (!pot_primed) { pot_filtered = raw.pot; pot_primed = true; }
+    else pot_filtered += pot_coeff * (raw.pot - pot_filtered);
+
+    if (fabsf(pot_filtered - pot_published) > POT_HYSTERESIS) {
+        pot_published = pot_filtered;
+        pot_tick = tick;
+    }
+
+    Flush();
+}
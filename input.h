@@ -0,0 +1,85 @@
+#pragma once
+#include "event_queue.h"
+#include <cstdint>
+
+// --- INPUT SCANNER ---
+// Debounces the encoder, the two switches and filters the pot. Pure logic:
+// Scan() is fed raw pin levels at a fixed rate (from a timer on the Seed, from
+// a recorded trace on the host) and publishes events for the main loop.
+
+// Raw levels, true = active (switch closed / quadrature line low)
+struct RawInputs {
+    bool  enc_a;
+    bool  enc_b;
+    bool  enc_click;
+    bool  button;
+    float pot; // 0..1
+};
+
+// The pot is not queued: read GetPot()/GetPotTick(). Switch events carry a
+// count in 'value', above 1 only if the main loop fell behind.
+enum InputEventType {
+    IN_ENC_TURN,    // value = +/- steps
+    IN_ENC_PRESS,
+    IN_ENC_RELEASE,
+    IN_BTN_PRESS,   // rate limited, see BUTTON_LOCKOUT_MS
+    IN_BTN_RELEASE,
+    IN_EVENT_TYPES
+};
+
+struct InputEvent {
+    InputEventType type;
+    int32_t  value;
+    float    pot;
+    uint32_t tick; // Caller's timestamp at the scan that produced it
+};
+
+class InputScanner {
+public:
+    static const uint32_t BUTTON_LOCKOUT_MS = 200;
+    static constexpr float POT_SMOOTH_SEC   = 0.005f;
+    static constexpr float POT_HYSTERESIS   = 0.002f;
+
+    void Init(float scan_rate);
+
+    // Scan context (timer interrupt): producer side of the event queue.
+    // now_ms drives the lockout; 'tick' is a finer timestamp (the hardware
+    // tick on the Seed) stored in the events so the main loop can place them
+    // at the sample where the input happened, however late it gets to them.
+    void Scan(const RawInputs& raw, uint32_t now_ms, uint32_t tick);
+
+    // Main loop: consumer side
+    bool PopEvent(InputEvent& ev) { return events.Pop(ev); }
+    bool EncoderPressed() const { return enc_down; }
+    bool ButtonPressed() const { return btn_down; }
+    float GetPot() const { return pot_published; }
+    uint32_t GetPotTick() const { return pot_tick; }
+
+private:
+    // Adds to the pending count for 'type'; Flush pushes whatever fits, so a
+    // full queue delays events instead of dropping them.
+    void Publish(InputEventType type, int32_t value, uint32_t tick);
+    void Flush();
+
+    SpscQueue<InputEvent, 32> events;
+
+    // Quadrature history (2 bits each)
+    uint8_t quad_a, quad_b;
+
+    // Not yet queued, per type; tick of the first unqueued occurrence
+    int32_t  pending[IN_EVENT_TYPES];
+    uint32_t pending_tick[IN_EVENT_TYPES];
+
+    // Debounce shift registers: 0xff = stable pressed, 0x00 = stable released
+    uint8_t enc_state;
+    uint8_t btn_state;
+    volatile bool enc_down; // Debounced state
+    volatile bool btn_down;
+    uint32_t last_btn_time;
+
+    float pot_coeff;
+    float pot_filtered;
+    volatile float pot_published;
+    volatile uint32_t pot_tick;
+    bool  pot_primed;
+};
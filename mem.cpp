@@ -0,0 +1,14 @@
+#include "mem.h"
+
+static const size_t SDRAM_POOL_SIZE = 256 * 1024;
+
+SDRAM_BSS alignas(32) static uint8_t sdram_pool[SDRAM_POOL_SIZE];
+
+namespace mem {
+    MemArena sdram;
+
+    void Init()
+    {
+        sdram.Init("SDRAM", sdram_pool, SDRAM_POOL_SIZE);
+    }
+}
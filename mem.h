@@ -0,0 +1,84 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// --- MEMORY PLACEMENT (STM32H750) ---
+// ITCM   64K  : hot audio code
+// DTCM  128K  : per-sample DSP state (engine, oscillators, filters)
+// AXI   512K  : default .bss/.data
+// SDRAM  64M  : bulk buffers (reverb delay lines)
+// Data placement uses libDaisy's own macros so it follows its linker script;
+// libDaisy has none for ITCM code. NOLOAD sections are not zeroed at startup:
+// whoever allocates from them must clear what they use.
+// `make memreport` checks the result against the map file.
+// ITCM_TEXT is noinline so the copy in ITCM is the only one; per-sample
+// helpers of an ITCM function are ITCM_INLINE instead, folded into it rather
+// than called once per sample.
+// Known gap: DaisySP comes prebuilt (libdaisysp.a) and libDaisy's linker
+// script puts all its .text in flash, so Oscillator::Process and
+// Overdrive::Process (8 calls per sample) run from flash through the AXI
+// cache. Moving them needs a linker script rule for those objects.
+#if defined(__arm__)
+#include "daisy_core.h"
+#define ITCM_TEXT __attribute__((section(".itcmram"), noinline))
+#define DTCM_BSS  DTCM_MEM_SECTION
+#define SDRAM_BSS DSY_SDRAM_BSS
+#else
+// Host builds (renders, tools): everything in normal memory
+#define ITCM_TEXT
+#define DTCM_BSS
+#define SDRAM_BSS
+#endif
+// Same on the host, so renders measure the code shape the Seed runs
+#define ITCM_INLINE inline __attribute__((always_inline))
+
+// Bump allocator over one memory region. Allocations happen at Init time and
+// are never freed individually.
+class MemArena {
+public:
+    void Init(const char* region_name, uint8_t* base, size_t size) {
+        name = region_name;
+        mem = base;
+        capacity = size;
+        used = 0;
+        peak_request = 0;
+    }
+
+    // Returns nullptr when the region is exhausted.
+    void* Allocate(size_t bytes, size_t align = 8) {
+        size_t start = (used + align - 1) & ~(align - 1);
+        if (start + bytes > capacity) {
+            if (bytes > peak_request) peak_request = bytes;
+            return nullptr;
+        }
+        used = start + bytes;
+        return mem + start;
+    }
+
+    template <typename T>
+    T* Allocate(size_t count) {
+        return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    const char* GetName() const { return name; }
+    size_t GetUsed() const { return used; }
+    size_t GetCapacity() const { return capacity; }
+    // Largest request that did not fit (0 if none failed)
+    size_t GetFailedRequest() const { return peak_request; }
+
+private:
+    const char* name;
+    uint8_t* mem;
+    size_t capacity;
+    size_t used;
+    size_t peak_request;
+};
+
+// Small, hot state is placed directly with DTCM_BSS; arenas are for buffers
+// sized at Init.
+namespace mem {
+    extern MemArena sdram;
+
+    // Point the arenas at their pools. Call before any component Init.
+    void Init();
+}
@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""Per-region, per-component memory report from the GNU ld map file.
+
+Usage: mem_report.py build/testbox.map
+
+Prints how many bytes each object file puts in each STM32H750 memory region
+and exits with status 1 if a symbol of the audio hot set is not in
+tightly-coupled memory, or is missing from the map (see HOT_SET).
+"""
+import re
+import sys
+from collections import defaultdict
+
+# name, start, size
+REGIONS = [
+    ("ITCM",  0x00000000, 64 * 1024),
+    ("FLASH", 0x08000000, 128 * 1024),
+    ("DTCM",  0x20000000, 128 * 1024),
+    ("AXI",   0x24000000, 512 * 1024),
+    ("SRAM1-3", 0x30000000, 288 * 1024),
+    ("SRAM4", 0x38000000, 64 * 1024),
+    ("BKPSRAM", 0x38800000, 4 * 1024),
+    ("QSPI",  0x90000000, 8 * 1024 * 1024),
+    ("SDRAM", 0xC0000000, 64 * 1024 * 1024),
+]
+
+# Symbols that must stay in TCM: (pattern, allowed regions). Patterns match
+# both mangled and demangled names.
+HOT_SET = [
+    (r"AudioCallback",                         ("ITCM",)),
+    (r"Processing::ProcessBlock|_ZN10Processing12ProcessBlock", ("ITCM",)),
+    (r"^engine$",                               ("DTCM",)),
+]
+
+# Per-sample helpers that must be folded into an ITCM function (ITCM_INLINE):
+# an out-of-line copy means a call per sample, possibly from flash
+INLINED = [
+    r"Processing::Process\(|_ZN10Processing7Process",
+]
+
+# Called per sample but linked from libdaisysp.a, which this tree cannot
+# place (see mem.h). Reported, not checked, so the gap stays visible.
+LIBRARY_GAPS = [
+    (r"daisysp::Oscillator::Process\(|_ZN7daisysp10Oscillator7ProcessEv", "6 calls/sample"),
+    (r"daisysp::Overdrive::Process\(|_ZN7daisysp9Overdrive7ProcessEf",   "2 calls/sample"),
+]
+
+SECTION_RE = re.compile(r"^ (\.\S+)(?:\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.*))?$")
+CONT_RE    = re.compile(r"^\s+(0x[0-9a-f]+)\s+(0x[0-9a-f]+)\s+(.*)$")
+SYMBOL_RE  = re.compile(r"^\s+(0x[0-9a-f]+)\s+(\S.*)$")
+
+
+def region_of(addr):
+    for name, start, size in REGIONS:
+        if start <= addr < start + size:
+            return name
+    return None
+
+
+def component_of(path):
+    path = path.strip()
+    # libDaisy.a(system.o) -> libDaisy.a
+    m = re.match(r"(.*?\.a)\(", path)
+    if m:
+        path = m.group(1)
+    return path.replace("\\", "/").split("/")[-1]
+
+
+def parse(map_path):
+    usage = defaultdict(lambda: defaultdict(int))
+    symbols = {}
+    in_map = False
+    pending_section = None
+
+    with open(map_path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Linker script and memory map"):
+                in_map = True
+                continue
+            if not in_map or line.startswith("/DISCARD/"):
+                continue
+
+            # Input section, possibly wrapped onto the next line
+            m = SECTION_RE.match(line)
+            if m:
+                if m.group(2) is None:
+                    pending_section = m.group(1)
+                    continue
+                addr, size, obj = int(m.group(2), 16), int(m.group(3), 16), m.group(4)
+                pending_section = None
+            else:
+                m = CONT_RE.match(line) if pending_section else None
+                if m:
+                    addr, size, obj = int(m.group(1), 16), int(m.group(2), 16), m.group(3)
+                    pending_section = None
+                else:
+                    s = SYMBOL_RE.match(line)
+                    if s and not s.group(2).startswith("0x"):
+                        symbols[s.group(2).strip()] = int(s.group(1), 16)
+                    continue
+
+            region = region_of(addr)
+            if region and size:
+                usage[region][component_of(obj)] += size
+
+    return usage, symbols
+
+
+def main():
+    if len(sys.argv) != 2:
+        print(__doc__)
+        return 2
+
+    usage, symbols = parse(sys.argv[1])
+
+    for name, _, capacity in REGIONS:
+        comps = usage.get(name)
+        if not comps:
+            continue
+        total = sum(comps.values())
+        print("%-8s %8d / %8d bytes (%5.1f%%)" % (name, total, capacity, 100.0 * total / capacity))
+        for comp, size in sorted(comps.items(), key=lambda kv: -kv[1]):
+            print("    %-32s %8d" % (comp, size))
+
+    failed = False
+    print("\nAudio hot set:")
+    for pattern, allowed in HOT_SET:
+        hits = [(sym, addr) for sym, addr in symbols.items() if re.search(pattern, sym)]
+        if not hits:
+            # A renamed or inlined symbol would otherwise drop out of the check
+            print("    %-40s NOT FOUND (inlined or renamed? update HOT_SET)" % pattern)
+            failed = True
+            continue
+        for sym, addr in hits:
+            region = region_of(addr)
+            ok = region in allowed
+            failed |= not ok
+            print("    %-40s %-6s %s" % (sym[:40], region, "ok" if ok else "SPILLED, expected " + "/".join(allowed)))
+
+    for pattern in INLINED:
+        for sym, addr in symbols.items():
+            if re.search(pattern, sym):
+                failed = True
+                print("    %-40s %-6s NOT INLINED, expected no out-of-line copy" % (sym[:40], region_of(addr)))
+
+    print("\nDaisySP on the audio path (not placed by this tree):")
+    for pattern, calls in LIBRARY_GAPS:
+        hits = [(sym, addr) for sym, addr in symbols.items() if re.search(pattern, sym)]
+        if not hits:
+            print("    %-40s not found (inlined?)" % pattern)
+        for sym, addr in hits:
+            region = region_of(addr)
+            print("    %-40s %-6s %s%s" % (sym[:40], region, calls, "" if region == "ITCM" else ", GAP: runs from " + region))
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
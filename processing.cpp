@@ -17,8 +17,8 @@ void Processing::Init(float sr)
     sweep_lfo.SetWaveform(daisysp::Oscillator::WAVE_TRI);
     sweep_lfo.SetAmp(1.0f);
 
-    filt_l.Init(sample_rate);   filt_r.Init(sample_rate);
-    phaser_l.Init(sample_rate); phaser_r.Init(sample_rate);
+    filter.Init(sample_rate);
+    phaser.Init(sample_rate);
     drive_l.Init();             drive_r.Init();
     
     // Fixed Dampening (7kHz) - Custom LPF Init
@@ -27,8 +27,10 @@ void Processing::Init(float sr)
     fixed_lpf_l.SetFreq(sample_rate, 7000.0f);
     fixed_lpf_r.SetFreq(sample_rate, 7000.0f);
 
-    reverb.Init(sample_rate);
+    reverb.Init(sample_rate, mem::sdram);
 
+    sample_clock = 0;
+    SeedRandom(1);
     Reset();
 }
 
@@ -56,7 +58,7 @@ void Processing::Reset()
 
 void Processing::Randomize()
 {
-    auto rnd = []() { return rand() / (float)RAND_MAX; };
+    auto rnd = [this]() { return RandomFloat(); };
 
     p_freq      = 55.0f + (rnd() * 2945.0f);
     p_waveform  = rnd();
@@ -74,7 +76,7 @@ void Processing::Randomize()
     p_sweep_rate = rnd() * 0.4f;
 }
 
-void Processing::Process(float &outL, float &outR)
+ITCM_INLINE void Processing::Process(float &outL, float &outR)
 {
     if (is_muted) { outL = 0.0f; outR = 0.0f; return; }
 
@@ -122,27 +124,11 @@ void Processing::Process(float &outL, float &outR)
         raw_r = raw_r * (1.0f - p_dist) + dr * p_dist;
     }
 
-    if(p_phaser > 0.01f) {
-        phaser_l.SetLfoDepth(p_phaser); phaser_r.SetLfoDepth(p_phaser);
-        phaser_l.SetFreq(0.5f + (p_phaser * 2.0f)); 
-        phaser_r.SetFreq(0.4f + (p_phaser * 2.1f));
-        raw_l = phaser_l.Process(raw_l); raw_r = phaser_r.Process(raw_r);
-    }
+    // LFO and coefficients are updated per block segment in ProcessBlock
+    if(p_phaser > 0.01f) phaser.Process(raw_l, raw_r);
 
-    filt_l.SetRes(0.1f); filt_r.SetRes(0.1f);
-    if (p_filter < 0.45f) {
-        float cutoff = 100.0f + (p_filter / 0.45f) * 10000.0f;
-        filt_l.SetFreq(cutoff); filt_r.SetFreq(cutoff);
-        filt_l.Process(raw_l); filt_r.Process(raw_r);
-        raw_l = filt_l.Low(); raw_r = filt_r.Low();
-    }
-    else if (p_filter > 0.55f) {
-        float norm = (p_filter - 0.55f) / 0.45f;
-        float cutoff = 50.0f + (norm * norm) * 8000.0f;
-        filt_l.SetFreq(cutoff); filt_r.SetFreq(cutoff);
-        filt_l.Process(raw_l); filt_r.Process(raw_r);
-        raw_l = filt_l.High(); raw_r = filt_r.High();
-    }
+    // Coefficients are updated per block segment in ProcessBlock
+    filter.Process(raw_l, raw_r);
 
     // 3. Fixed High Dampening (7kHz)
     raw_l = fixed_lpf_l.Process(raw_l);
@@ -159,6 +145,43 @@ void Processing::Process(float &outL, float &outR)
     outR = SoftLimit(raw_r);
 }
 
+void Processing::ProcessBlock(float* outL, float* outR, size_t size)
+{
+    uint32_t block_start = sample_clock;
+    size_t pos = 0;
+    ControlEvent ev;
+
+    while (pos < size) {
+        // Apply everything due at or before this sample (late events land here)
+        while (events.Peek(ev) && (int32_t)(ev.time - (block_start + pos)) <= 0) {
+            events.Pop(ev);
+            ApplyEvent(ev);
+        }
+
+        // Render up to the next event inside this block
+        size_t end = size;
+        if (events.Peek(ev)) {
+            uint32_t offset = ev.time - block_start;
+            if (offset < end) end = offset;
+        }
+
+        filter.SetMorph(p_filter, end - pos);
+        phaser.SetParams(p_phaser, 0.5f + (p_phaser * 2.0f), end - pos);
+        for (; pos < end; pos++) Process(outL[pos], outR[pos]);
+    }
+
+    sample_clock = block_start + size;
+}
+
+void Processing::ApplyEvent(const ControlEvent& ev)
+{
+    switch (ev.type) {
+        case EVT_CONTROLS:  UpdateControls(ev.enc_inc, ev.button, ev.knob); break;
+        case EVT_RANDOMIZE: Randomize(); break;
+        case EVT_RESET:     Reset(); break;
+    }
+}
+
 void Processing::UpdateControls(int32_t enc_inc, bool button_trig, float knob_val)
 {
     if (button_trig) is_muted = !is_muted;
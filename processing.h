@@ -1,6 +1,9 @@
 #pragma once
 #include "daisysp.h"
 #include "daisy_seed.h"
+#include "event_queue.h"
+#include "mem.h"
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 
@@ -26,17 +29,282 @@ struct SimpleLPF {
     }
 };
 
+// --- ZDF MULTIMODE FILTER (Stereo, LP -> Bypass -> HP morph) ---
+// Topology-preserving SVF (trapezoidal integrators). Coefficients are only
+// recomputed when the morph value moves, using a tan() lookup table, and are
+// ramped across the block so cutoff changes stay click free.
+struct FilterCoeffs {
+    float g;     // tan(PI * fc / sr)
+    float k;     // 1 / Q
+    float m_lp, m_dry, m_hp;
+};
+
+class MorphFilter {
+public:
+    static const int TAN_TABLE_SIZE = 256;
+    static constexpr float TAN_TABLE_MAX = 0.25f; // fc / sr covered by the table
+    static constexpr float DAMPING = 0.875f;      // ~ old Svf SetRes(0.1f)
+
+    void Init(float sample_rate) {
+        sr = sample_rate;
+        for(int i = 0; i <= TAN_TABLE_SIZE; i++) {
+            tan_table[i] = tanf(PI_F * TAN_TABLE_MAX * (float)i / TAN_TABLE_SIZE);
+        }
+        ic1[0] = ic1[1] = ic2[0] = ic2[1] = 0.0f;
+        last_morph = -1.0f;
+        cur = target = ComputeCoeffs(0.5f);
+        step_g = step_lp = step_dry = step_hp = 0.0f;
+        ramp_left = 0;
+        UpdateGains();
+    }
+
+    // Morph: 0 = LP closed, 0.5 = bypass, 1 = HP fully open.
+    FilterCoeffs ComputeCoeffs(float morph) const {
+        FilterCoeffs c;
+        float cutoff;
+        if (morph < 0.5f) {
+            float x = morph / 0.5f;
+            cutoff = 100.0f + x * 10000.0f;
+            c.m_dry = SmoothStep((x - 0.8f) / 0.2f);
+            c.m_lp  = 1.0f - c.m_dry;
+            c.m_hp  = 0.0f;
+        } else {
+            float y = (morph - 0.5f) / 0.5f;
+            cutoff = 50.0f + (y * y) * 8000.0f;
+            c.m_dry = 1.0f - SmoothStep(y / 0.2f);
+            c.m_hp  = 1.0f - c.m_dry;
+            c.m_lp  = 0.0f;
+        }
+        c.g = TanLookup(cutoff / sr);
+        c.k = DAMPING;
+        return c;
+    }
+
+    // Control rate: call once per block (or block segment) of 'size' samples.
+    void SetMorph(float morph, size_t size) {
+        if (morph == last_morph || size == 0) return;
+        last_morph = morph;
+
+        target = ComputeCoeffs(morph);
+        float inv = 1.0f / (float)size;
+        step_g   = (target.g - cur.g) * inv;
+        step_lp  = (target.m_lp - cur.m_lp) * inv;
+        step_dry = (target.m_dry - cur.m_dry) * inv;
+        step_hp  = (target.m_hp - cur.m_hp) * inv;
+        ramp_left = size;
+    }
+
+    void Process(float& l, float& r) {
+        if (ramp_left > 0) {
+            // Land exactly on the target: accumulated steps leave a residue
+            // that shrinks block after block into denormals (slow on x86)
+            if (--ramp_left == 0) cur = target;
+            else { cur.g += step_g; cur.m_lp += step_lp; cur.m_dry += step_dry; cur.m_hp += step_hp; }
+            UpdateGains();
+        }
+
+        float in[2] = { l, r };
+        float out[2];
+        for (int ch = 0; ch < 2; ch++) {
+            float v3 = in[ch] - ic2[ch];
+            float v1 = a1 * ic1[ch] + a2 * v3;
+            float v2 = ic2[ch] + a2 * ic1[ch] + a3 * v3;
+            ic1[ch] = 2.0f * v1 - ic1[ch];
+            ic2[ch] = 2.0f * v2 - ic2[ch];
+
+            float high = in[ch] - cur.k * v1 - v2;
+            out[ch] = cur.m_lp * v2 + cur.m_dry * in[ch] + cur.m_hp * high;
+        }
+        l = out[0]; r = out[1];
+    }
+
+    // Magnitude (linear) at freq_hz of the filter described by 'c'. This is
+    // the bilinear-transformed SVF, i.e. exactly what Process() does.
+    float Response(const FilterCoeffs& c, float freq_hz) const {
+        float fn = freq_hz / sr;
+        if (fn > 0.499f) fn = 0.499f;
+        float w = tanf(PI_F * fn) / c.g; // Prewarped, normalised to cutoff
+        float w2 = w * w;
+        // H = (m_lp + m_dry * (1 - w^2 + j k w) - m_hp * w^2) / (1 - w^2 + j k w)
+        float den_re = 1.0f - w2;
+        float den_im = c.k * w;
+        float num_re = c.m_lp + c.m_dry * den_re - c.m_hp * w2;
+        float num_im = c.m_dry * den_im;
+        return sqrtf((num_re * num_re + num_im * num_im) / (den_re * den_re + den_im * den_im));
+    }
+
+private:
+    static float SmoothStep(float x) {
+        if (x <= 0.0f) return 0.0f;
+        if (x >= 1.0f) return 1.0f;
+        return x * x * (3.0f - 2.0f * x);
+    }
+
+    float TanLookup(float norm_freq) const {
+        float pos = norm_freq * (TAN_TABLE_SIZE / TAN_TABLE_MAX);
+        if (pos < 0.0f) pos = 0.0f;
+        if (pos > TAN_TABLE_SIZE - 1) pos = TAN_TABLE_SIZE - 1;
+        int idx = (int)pos;
+        float frac = pos - (float)idx;
+        return tan_table[idx] + (tan_table[idx + 1] - tan_table[idx]) * frac;
+    }
+
+    void UpdateGains() {
+        a1 = 1.0f / (1.0f + cur.g * (cur.g + cur.k));
+        a2 = cur.g * a1;
+        a3 = cur.g * a2;
+    }
+
+    float sr;
+    float tan_table[TAN_TABLE_SIZE + 1];
+
+    FilterCoeffs cur, target;
+    float a1, a2, a3;
+    float step_g, step_lp, step_dry, step_hp;
+    size_t ramp_left;
+    float last_morph;
+
+    float ic1[2], ic2[2];
+};
+
+// --- STEREO PHASER (Shared LFO) ---
+// One triangle LFO drives both channels, the right one a quarter cycle ahead
+// for width. LFO position -> allpass coefficient comes from a table, updated
+// at control rate and ramped per sample; both channels run in one loop.
+class StereoPhaser {
+public:
+    static const int STAGES = 4;
+    static const int TABLE_SIZE = 256;
+    static constexpr float MIN_FREQ   = 100.0f; // Allpass corner sweep, 6 octaves
+    static constexpr float OCTAVES    = 6.0f;
+    static constexpr float FEEDBACK   = 0.2f;
+
+    void Init(float sample_rate) {
+        sr = sample_rate;
+        for(int i = 0; i <= TABLE_SIZE; i++) {
+            float u = (float)i / TABLE_SIZE;
+            float t = tanf(PI_F * MIN_FREQ * powf(2.0f, u * OCTAVES) / sr);
+            coef_table[i] = (t - 1.0f) / (t + 1.0f);
+        }
+        lfo_phase = 0.0f;
+        for(int ch = 0; ch < 2; ch++) {
+            coef[ch] = coef_table[TABLE_SIZE / 2];
+            coef_step[ch] = 0.0f;
+            last[ch] = 0.0f;
+            for(int s = 0; s < STAGES; s++) state[s][ch] = 0.0f;
+        }
+        ramp_left = 0;
+    }
+
+    // Control rate: advance the LFO over the next 'size' samples and ramp
+    // the coefficients towards its position at the end of the segment.
+    void SetParams(float depth, float rate_hz, size_t size) {
+        if (size == 0) return;
+        lfo_phase += rate_hz * (float)size / sr;
+        lfo_phase -= floorf(lfo_phase);
+
+        float inv = 1.0f / (float)size;
+        for(int ch = 0; ch < 2; ch++) {
+            float ph = lfo_phase + (ch == 1 ? 0.25f : 0.0f);
+            ph -= floorf(ph);
+            float tri = (ph < 0.5f) ? (4.0f * ph - 1.0f) : (3.0f - 4.0f * ph);
+            float target = Lookup(0.5f + 0.5f * depth * tri);
+            coef_step[ch] = (target - coef[ch]) * inv;
+        }
+        ramp_left = size;
+    }
+
+    void Process(float& l, float& r) {
+        if (ramp_left > 0) {
+            coef[0] += coef_step[0]; coef[1] += coef_step[1];
+            ramp_left--;
+        }
+
+        float in[2] = { l, r };
+        float x[2];
+        for(int ch = 0; ch < 2; ch++) x[ch] = in[ch] + FEEDBACK * last[ch];
+
+        // First-order allpass (TDF-II): y = a*x + s, s = x - a*y
+        for(int s = 0; s < STAGES; s++) {
+            for(int ch = 0; ch < 2; ch++) {
+                float y = coef[ch] * x[ch] + state[s][ch];
+                state[s][ch] = x[ch] - coef[ch] * y;
+                x[ch] = y;
+            }
+        }
+
+        for(int ch = 0; ch < 2; ch++) last[ch] = x[ch];
+        l = (in[0] + x[0]) * 0.5f;
+        r = (in[1] + x[1]) * 0.5f;
+    }
+
+private:
+    float Lookup(float u) const {
+        float pos = u * TABLE_SIZE;
+        if (pos < 0.0f) pos = 0.0f;
+        if (pos > TABLE_SIZE - 1) pos = TABLE_SIZE - 1;
+        int idx = (int)pos;
+        float frac = pos - (float)idx;
+        return coef_table[idx] + (coef_table[idx + 1] - coef_table[idx]) * frac;
+    }
+
+    float sr;
+    float coef_table[TABLE_SIZE + 1];
+    float lfo_phase;
+    float coef[2], coef_step[2];
+    size_t ramp_left;
+    float state[STAGES][2];
+    float last[2];
+};
+
+// --- ARENA DELAY LINE ---
+// Integer-delay equivalent of daisysp::DelayLine, but the buffer comes from
+// a MemArena so bulk delay memory can live outside the engine object.
+struct ArenaDelay {
+    float* line;
+    size_t size;
+    size_t write_ptr;
+    size_t delay;
+
+    // Allocates only; the buffer is not cleared (SDRAM is not zeroed at
+    // boot). Call Clear() / let the owner clear it before the first Read().
+    bool Init(MemArena& arena, size_t max_size) {
+        line = arena.Allocate<float>(max_size);
+        size = line ? max_size : 0;
+        write_ptr = 0;
+        delay = 1;
+        return line != nullptr;
+    }
+
+    void Clear(size_t start, size_t count) {
+        for(size_t i = start; i < start + count && i < size; i++) line[i] = 0.0f;
+    }
+
+    void SetDelay(size_t d) { delay = d < size ? d : size - 1; }
+
+    void Write(float sample) {
+        line[write_ptr] = sample;
+        write_ptr = (write_ptr - 1 + size) % size;
+    }
+
+    float Read() const { return line[(write_ptr + delay) % size]; }
+};
+
 // --- CUSTOM FREEVERB (Modulated) ---
 class NiceReverb {
 public:
-    void Init(float sample_rate) {
-        combs_l[0].Init(); combs_l[1].Init(); combs_l[2].Init(); combs_l[3].Init();
-        combs_l[4].Init(); combs_l[5].Init(); combs_l[6].Init(); combs_l[7].Init();
-        ap_l[0].Init();    ap_l[1].Init();    ap_l[2].Init();    ap_l[3].Init();
+    static const size_t COMB_SIZE = 1750;
+    static const size_t AP_SIZE   = 600;
+
+    static const int NUM_LINES = 24;
+    static constexpr float FADE_IN_SEC = 0.25f;
 
-        combs_r[0].Init(); combs_r[1].Init(); combs_r[2].Init(); combs_r[3].Init();
-        combs_r[4].Init(); combs_r[5].Init(); combs_r[6].Init(); combs_r[7].Init();
-        ap_r[0].Init();    ap_r[1].Init();    ap_r[2].Init();    ap_r[3].Init();
+    // Delay memory (~128 KB) is taken from 'arena' but not cleared here, so
+    // Init is fast. Until ClearStep() has zeroed all of it the reverb passes
+    // the dry signal through, then fades in over FADE_IN_SEC.
+    bool Init(float sample_rate, MemArena& arena) {
+        allocated = true;
+        for(int i=0; i<NUM_LINES; i++) allocated &= Line(i).Init(arena, i < 16 ? COMB_SIZE : AP_SIZE);
 
         for(int i=0; i<8; i++) { damp_l[i] = 0.0f; damp_r[i] = 0.0f; }
         
@@ -44,10 +312,34 @@ public:
         mod_lfo.SetWaveform(daisysp::Oscillator::WAVE_SIN);
         mod_lfo.SetFreq(0.3f);
         mod_lfo.SetAmp(1.0f);
+
+        ready.store(false);
+        clear_line = 0;
+        clear_pos = 0;
+        fade = 0.0f;
+        fade_inc = 1.0f / (FADE_IN_SEC * sample_rate);
+        return allocated;
+    }
+
+    // Zero up to 'budget' samples of delay memory (main loop). Returns true
+    // once all of it is clear.
+    bool ClearStep(size_t budget) {
+        while(budget > 0 && clear_line < NUM_LINES) {
+            ArenaDelay& dl = Line(clear_line);
+            size_t n = dl.size - clear_pos;
+            if(n > budget) n = budget;
+            dl.Clear(clear_pos, n);
+            clear_pos += n;
+            budget -= n;
+            if(clear_pos >= dl.size) { clear_line++; clear_pos = 0; }
+        }
+        if(clear_line < NUM_LINES) return false;
+        if(allocated && !ready.load(std::memory_order_relaxed)) ready.store(true, std::memory_order_release);
+        return true;
     }
 
     void Process(float in, float amt, float length, float tone, float& outL, float& outR) {
-        if(amt < 0.01f) { outL = in; outR = in; return; }
+        if(amt < 0.01f || !ready.load(std::memory_order_acquire)) { outL = in; outR = in; return; }
 
         float feedback = 0.7f + (length * 0.28f);
         float damping  = 0.0f + ((1.0f - tone) * 0.4f);
@@ -71,12 +363,21 @@ public:
             wet_r = ProcessAllPass(ap_r[i], wet_r, ap_tunes[i] + 23);
         }
 
-        outL = in * (1.0f - amt * 0.5f) + wet_l * amt * 0.015f;
-        outR = in * (1.0f - amt * 0.5f) + wet_r * amt * 0.015f;
+        if(fade < 1.0f) { fade += fade_inc; if(fade > 1.0f) fade = 1.0f; }
+        float mix = amt * fade;
+        outL = in * (1.0f - mix * 0.5f) + wet_l * mix * 0.015f;
+        outR = in * (1.0f - mix * 0.5f) + wet_r * mix * 0.015f;
     }
 
 private:
-    float ProcessComb(daisysp::DelayLine<float, 1750>& dl, float& history, float in, float fb, float damp, int delay) {
+    ArenaDelay& Line(int i) {
+        if(i < 8)  return combs_l[i];
+        if(i < 16) return combs_r[i - 8];
+        if(i < 20) return ap_l[i - 16];
+        return ap_r[i - 20];
+    }
+
+    float ProcessComb(ArenaDelay& dl, float& history, float in, float fb, float damp, int delay) {
         float output = dl.Read();
         history = output * (1.0f - damp) + history * damp;
         dl.Write(in + history * fb);
@@ -89,7 +390,7 @@ private:
         return output;
     }
     
-    float ProcessAllPass(daisysp::DelayLine<float, 600>& dl, float in, int delay) {
+    float ProcessAllPass(ArenaDelay& dl, float in, int delay) {
         float read = dl.Read();
         float write = in + (read * 0.5f);
         dl.Write(write);
@@ -97,10 +398,16 @@ private:
         return read - (write * 0.5f);
     }
 
-    daisysp::DelayLine<float, 1750> combs_l[8];
-    daisysp::DelayLine<float, 1750> combs_r[8];
-    daisysp::DelayLine<float, 600>  ap_l[4];
-    daisysp::DelayLine<float, 600>  ap_r[4];
+    ArenaDelay combs_l[8];
+    ArenaDelay combs_r[8];
+    ArenaDelay ap_l[4];
+    ArenaDelay ap_r[4];
+    bool allocated;
+    std::atomic<bool> ready; // Written by the main loop, read by audio
+
+    int    clear_line;
+    size_t clear_pos;
+    float  fade, fade_inc;
     float damp_l[8]; float damp_r[8];
     daisysp::Oscillator mod_lfo;
 };
@@ -123,12 +430,45 @@ enum SynthParam {
     PARAM_COUNT
 };
 
+// --- TIMESTAMPED CONTROL EVENTS ---
+// 'time' is a position on the engine's sample clock. ProcessBlock splits the
+// block at each event and applies it at exactly that sample.
+enum ControlEventType {
+    EVT_CONTROLS,  // enc_inc / button / knob, as UpdateControls
+    EVT_RANDOMIZE,
+    EVT_RESET
+};
+
+struct ControlEvent {
+    uint32_t time;
+    ControlEventType type;
+    int32_t enc_inc;
+    bool button;
+    float knob;
+};
+
 class Processing {
 public:
     void Init(float sample_rate);
-    void Process(float &outL, float &outR);
+    ITCM_TEXT void ProcessBlock(float* outL, float* outR, size_t size);
+
+    // Queue an event for the audio thread (single producer). Returns false
+    // when the queue is full.
+    bool PostEvent(const ControlEvent& ev) { return events.Push(ev); }
+    // Sample position of the start of the next block
+    uint32_t GetSampleClock() const { return sample_clock; }
+
     void UpdateControls(int32_t enc_inc, bool button_trig, float knob_val);
+    // Deferred init (reverb memory), a 'budget' of samples per call from the
+    // main loop. Returns true when done. Offline renders can loop on it right
+    // after Init.
+    bool InitStep(size_t budget) { return reverb.ClearStep(budget); }
+
     void Randomize();
+    // Randomize draws from an engine-owned PRNG, so a given seed always
+    // produces the same sequence of patches. Init seeds it with 1 (host
+    // renders); the firmware reseeds from the hardware RNG at boot.
+    void SeedRandom(uint32_t seed) { rng_state = seed ? seed : 1; }
     void Reset();
 
     bool IsMuted() const { return is_muted; }
@@ -136,15 +476,20 @@ public:
     const char* GetParamName(int index);
     float GetParamValue(int index);
     bool IsParamLocked() const { return param_locked; }
+    // Magnitude response of the filter at the current FILTER setting
+    float GetFilterResponse(float freq_hz) const { return filter.Response(filter.ComputeCoeffs(p_filter), freq_hz); }
 
 private:
+    // One sample; only ProcessBlock calls it, so it is folded in there
+    ITCM_INLINE void Process(float &outL, float &outR);
+
     daisysp::Oscillator osc_a_l, osc_b_l;
     daisysp::Oscillator osc_a_r, osc_b_r;
     daisysp::Oscillator lfo; // Wobble
     daisysp::Oscillator sweep_lfo; // Slow Sweep
 
-    daisysp::Svf    filt_l, filt_r;
-    daisysp::Phaser phaser_l, phaser_r;
+    MorphFilter     filter;
+    StereoPhaser    phaser;
     daisysp::Overdrive drive_l, drive_r;
     
     // Changed: Using local SimpleLPF instead of daisysp::Tone
@@ -153,6 +498,19 @@ private:
 
     NiceReverb reverb; 
 
+    SpscQueue<ControlEvent, 32> events;
+    volatile uint32_t sample_clock;
+    void ApplyEvent(const ControlEvent& ev);
+
+    uint32_t rng_state;
+    inline float RandomFloat() {
+        // xorshift32
+        rng_state ^= rng_state << 13;
+        rng_state ^= rng_state >> 17;
+        rng_state ^= rng_state << 5;
+        return (rng_state >> 8) * (1.0f / 16777216.0f);
+    }
+
     bool is_muted;
     float sample_rate;
     int current_param;
@@ -0,0 +1,112 @@
+#include "scheduler.h"
+
+void Scheduler::Init(ClockFn clock_fn)
+{
+    clock = clock_fn;
+    num_tasks = 0;
+}
+
+int Scheduler::AddTask(TaskFn fn, uint32_t period_us, uint32_t deadline_us)
+{
+    if (num_tasks >= MAX_TASKS) return -1;
+
+    Task& t = tasks[num_tasks];
+    t.fn = fn;
+    t.period_us = period_us;
+    t.deadline_us = deadline_us;
+    t.next_due = clock() + period_us;
+    t.signal_time = 0;
+    t.pending = false;
+    t.runs = 0;
+    t.missed = 0;
+    t.max_lateness_us = 0;
+    t.max_runtime_us = 0;
+
+    return num_tasks++;
+}
+
+int Scheduler::AddPeriodic(TaskFn fn, uint32_t period_us, uint32_t deadline_us)
+{
+    if (period_us == 0) return -1;
+    return AddTask(fn, period_us, deadline_us);
+}
+
+int Scheduler::AddEvent(TaskFn fn, uint32_t deadline_us)
+{
+    return AddTask(fn, 0, deadline_us);
+}
+
+void Scheduler::Signal(int id)
+{
+    if (id < 0 || id >= num_tasks) return;
+    Task& t = tasks[id];
+    if (t.pending) return; // Keep the first signal time for lateness
+    t.signal_time = clock();
+    t.pending = true;
+}
+
+void Scheduler::RunTask(Task& t, uint32_t due, uint32_t now)
+{
+    // Unsigned subtraction keeps this correct across clock wrap
+    uint32_t lateness = now - due;
+    if (lateness > t.max_lateness_us) t.max_lateness_us = lateness;
+    if (lateness > t.deadline_us) t.missed++;
+
+    t.fn(now);
+    t.runs++;
+
+    uint32_t runtime = clock() - now;
+    if (runtime > t.max_runtime_us) t.max_runtime_us = runtime;
+}
+
+bool Scheduler::RunPending()
+{
+    bool ran = false;
+
+    for (int i = 0; i < num_tasks; i++) {
+        Task& t = tasks[i];
+        uint32_t now = clock();
+
+        if (t.period_us == 0) {
+            if (!t.pending) continue;
+            t.pending = false;
+            RunTask(t, t.signal_time, now);
+            ran = true;
+        }
+        else if ((int32_t)(now - t.next_due) >= 0) {
+            uint32_t due = t.next_due;
+            t.next_due += t.period_us;
+            // Fell more than a period behind: skip the backlog instead of
+            // running the task back to back.
+            if ((int32_t)(now - t.next_due) >= 0) t.next_due = now + t.period_us;
+            RunTask(t, due, now);
+            ran = true;
+        }
+    }
+
+    return ran;
+}
+
+uint32_t Scheduler::TimeUntilNext() const
+{
+    uint32_t now = clock();
+    uint32_t best = 0xFFFFFFFF;
+
+    for (int i = 0; i < num_tasks; i++) {
+        const Task& t = tasks[i];
+        if (t.period_us == 0) continue;
+        int32_t wait = (int32_t)(t.next_due - now);
+        if (wait <= 0) return 0;
+        if ((uint32_t)wait < best) best = (uint32_t)wait;
+    }
+
+    return best;
+}
+
+bool Scheduler::HasSignalled() const
+{
+    for (int i = 0; i < num_tasks; i++) {
+        if (tasks[i].period_us == 0 && tasks[i].pending) return true;
+    }
+    return false;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// --- COOPERATIVE SCHEDULER ---
+// Runs periodic and event-triggered tasks from the main loop. It knows nothing
+// about the hardware: time comes from the clock function given to Init
+// (a TickClock on the Seed, a plain counter on the host), so the main loop
+// can sleep between events and every task gets a measurable deadline.
+//
+// Times are compared with wrapping 32-bit arithmetic, so the clock must wrap
+// at exactly 2^32 us.
+class Scheduler {
+public:
+    typedef uint32_t (*ClockFn)();
+    typedef void (*TaskFn)(uint32_t now);
+
+    static const int MAX_TASKS = 8;
+
+    struct Task {
+        TaskFn   fn;
+        uint32_t period_us;    // 0 = event-triggered
+        uint32_t deadline_us;  // allowed delay between due/signal time and start
+        uint32_t next_due;
+        uint32_t signal_time;
+        volatile bool pending;
+
+        // Stats
+        uint32_t runs;
+        uint32_t missed;
+        uint32_t max_lateness_us;
+        uint32_t max_runtime_us;
+    };
+
+    void Init(ClockFn clock_fn);
+
+    // Both return a task id, or -1 when the table is full.
+    int AddPeriodic(TaskFn fn, uint32_t period_us, uint32_t deadline_us);
+    int AddEvent(TaskFn fn, uint32_t deadline_us);
+
+    // Marks an event task as ready. Main loop only (tasks included): the
+    // pending check, the signal time and the clear in RunPending are not
+    // atomic with respect to each other, and the clock is not reentrant.
+    // Interrupts hand work over through a queue or flag that a periodic task
+    // polls instead.
+    void Signal(int id);
+
+    // Runs every task that is due or signalled, once. Returns false if
+    // nothing ran, i.e. the caller may sleep until the next interrupt.
+    bool RunPending();
+
+    // Microseconds until the next periodic task is due (0 if one is due now).
+    uint32_t TimeUntilNext() const;
+    bool HasSignalled() const;
+
+    const Task& GetTask(int id) const { return tasks[id]; }
+    int GetTaskCount() const { return num_tasks; }
+
+private:
+    int AddTask(TaskFn fn, uint32_t period_us, uint32_t deadline_us);
+    void RunTask(Task& t, uint32_t due, uint32_t now);
+
+    ClockFn clock;
+    Task    tasks[MAX_TASKS];
+    int     num_tasks;
+};
+
+// Microsecond clock built from a free-running hardware tick counter. Dividing
+// the counter down (System::GetUs) wraps at 2^32 ticks, which is not 2^32 us,
+// so elapsed ticks are accumulated in software instead. Update() must run at
+// least once per counter period (~21 s for a 200 MHz counter).
+class TickClock {
+public:
+    // 'wrap' is the counter modulus, 0 for a full 32-bit counter
+    void Init(uint32_t ticks_per_us, uint32_t ticks_now, uint32_t wrap = 0) {
+        per_us = ticks_per_us ? ticks_per_us : 1;
+        modulus = wrap;
+        last = ticks_now;
+        frac = 0;
+        us = 0;
+    }
+
+    uint32_t Update(uint32_t ticks) {
+        uint32_t delta = ticks - last;
+        if (modulus && ticks < last) delta += modulus;
+        last = ticks;
+        us += delta / per_us;
+        frac += delta % per_us;
+        if (frac >= per_us) { us++; frac -= per_us; }
+        return us;
+    }
+
+private:
+    uint32_t per_us, modulus, last, frac, us;
+};
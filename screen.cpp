@@ -152,24 +152,21 @@ static void DrawUnifiedWaveform(OledDisplay<OledDriver> &disp, int x, int y, int
     }
 }
 
-static void DrawFilterCurve(OledDisplay<OledDriver> &disp, int x, int y, int w, int h, float val)
+static void DrawFilterCurve(OledDisplay<OledDriver> &disp, int x, int y, int w, int h, const Processing& proc)
 {
     for(int i=0; i<w; i++) DrawPixelRot180(disp, x+i, y+h-1, true);
     int last_py = y + h - 1;
 
     for(int i=0; i<w; i++)
     {
+        // Log frequency axis 20 Hz .. 20 kHz, -30 dB .. +6 dB
         float t = (float)i / (float)w; 
-        float response = 1.0f;
-        if (val < 0.45f) {
-            float cutoff = val / 0.45f;
-            if (t > cutoff) response = 1.0f - (t - cutoff) * 8.0f;
-        } 
-        else if (val > 0.55f) {
-            float cutoff = (val - 0.55f) / 0.45f;
-            if (t < cutoff) response = 1.0f - (cutoff - t) * 8.0f;
-        }
+        float freq = 20.0f * powf(1000.0f, t);
+        float mag = proc.GetFilterResponse(freq);
+        float db = 20.0f * log10f(mag + 1e-6f);
+        float response = (db + 30.0f) / 36.0f;
         if(response < 0.0f) response = 0.0f;
+        if(response > 1.0f) response = 1.0f;
         int py = (y + h - 1) - (int)(response * (h - 4));
         DrawPixelRot180(disp, x + i, py, true);
         if(i > 0 && abs(py - last_py) > 1) {
@@ -194,7 +191,7 @@ void Screen::Init(DaisySeed &seed)
     display.Update();
 }
 
-void Screen::DrawStatus(Processing& proc, UiAction last_action, uint32_t time_since_act)
+void Screen::DrawStatus(Processing& proc, UiAction last_action, uint32_t time_since_act, float cpu_load)
 {
     display.Fill(false);
     
@@ -212,7 +209,7 @@ void Screen::DrawStatus(Processing& proc, UiAction last_action, uint32_t time_si
         DrawUnifiedWaveform(display, 0, 15, 128, 35, 0, 0, 0.0f, 0, 0, 0, 0, 0);
     }
     else if (p_idx == PARAM_FILTER) {
-        DrawFilterCurve(display, 0, 15, 128, 35, proc.GetParamValue(PARAM_FILTER));
+        DrawFilterCurve(display, 0, 15, 128, 35, proc);
     }
     else {
         DrawUnifiedWaveform(display, 0, 15, 128, 35, 
@@ -228,7 +225,8 @@ void Screen::DrawStatus(Processing& proc, UiAction last_action, uint32_t time_si
     }
 
     char tip[32] = "";
-    if (proc.IsMuted()) snprintf(tip, sizeof(tip), "Press btn to unmute");
+    if (cpu_load > CPU_WARN_LOAD) snprintf(tip, sizeof(tip), "CPU %d%% !", (int)(cpu_load * 100.0f));
+    else if (proc.IsMuted()) snprintf(tip, sizeof(tip), "Press btn to unmute");
     else if (last_action == ACT_NONE || time_since_act > 5000) snprintf(tip, sizeof(tip), "Touch me pls");
     else if (last_action == ACT_ENC) snprintf(tip, sizeof(tip), "Select Param");
     else if (last_action == ACT_KNOB) {
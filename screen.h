@@ -16,6 +16,9 @@ enum UiAction {
 
 struct Screen
 {
+    // Average audio CPU load (0..1) above which the tip line shows a warning
+    static constexpr float CPU_WARN_LOAD = 0.75f;
+
     void Init(daisy::DaisySeed &seed);
-    void DrawStatus(Processing& proc, UiAction last_action, uint32_t time_since_act);
+    void DrawStatus(Processing& proc, UiAction last_action, uint32_t time_since_act, float cpu_load);
 };
\ No newline at end of file
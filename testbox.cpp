@@ -3,113 +3,258 @@
 #include "hw.h"
 #include "processing.h"
 #include "screen.h"
+#include "scheduler.h"
+#include "mem.h"
+#include "util/CpuLoadMeter.h"
 
 using namespace daisy;
 using namespace daisysp;
 
 Hardware hw;
-Processing engine;
+DTCM_BSS Processing engine; // Per-sample state; reverb delay lines come from mem::sdram
 Screen screen;
+Scheduler scheduler;
+CpuLoadMeter cpu_meter;
 
-volatile int32_t encoder_presses = 0;
-volatile bool    button_pressed = false;
-volatile float   pot_value = 0.0f;
+// --- BOOT TIMELINE ---
+// System::GetUs() at the end of each startup stage (read it in the debugger).
+// Time to first sound is boot_timeline[BOOT_FIRST_BLOCK].
+enum BootStage {
+    BOOT_HW,
+    BOOT_ENGINE,
+    BOOT_AUDIO_START,
+    BOOT_FIRST_BLOCK,
+    BOOT_DISPLAY,
+    BOOT_REVERB,
+    BOOT_STAGE_COUNT
+};
+volatile uint32_t boot_timeline[BOOT_STAGE_COUNT];
+static void BootMark(BootStage stage) { boot_timeline[stage] = System::GetUs(); }
 
-void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size)
+// Hardware tick (System::GetTick) at which the current block started
+volatile uint32_t block_start_tick = 0;
+
+// Audio only: controls are scanned from the hardware timer
+ITCM_TEXT void AudioCallback(AudioHandle::InputBuffer in, AudioHandle::OutputBuffer out, size_t size)
 {
-    hw.encoder.Debounce();
-    hw.button.Debounce();
-    
-    encoder_presses += hw.encoder.Increment();
+    cpu_meter.OnBlockStart();
+    block_start_tick = System::GetTick();
+    engine.ProcessBlock(out[0], out[1], size);
+    cpu_meter.OnBlockEnd();
+    if (boot_timeline[BOOT_FIRST_BLOCK] == 0) BootMark(BOOT_FIRST_BLOCK);
+}
 
-    static uint32_t last_btn_time = 0;
-    if(hw.button.RisingEdge())
-    {
-        uint32_t now = System::GetNow();
-        if(now - last_btn_time > 200) 
-        {
-            button_pressed = true;
-            last_btn_time = now;
-        }
-    }
-    
-    pot_value = hw.pot.Process();
+// Scan-to-post delay absorbed without jitter. Events stamped at scan time
+// and posted within this many blocks play exactly EVENT_LATENCY_BLOCKS after
+// the input; a longer main loop stall (a blocking display update) makes them
+// late, and they are applied at the start of the next block.
+static const uint32_t EVENT_LATENCY_BLOCKS = 2;
+static float samples_per_tick = 0.0f;
+volatile uint32_t late_events = 0; // Stamped time already rendered when posted
 
-    float L, R;
-    for(size_t i = 0; i < size; i++)
-    {
-        engine.Process(L, R);
-        out[0][i] = L;
-        out[1][i] = R;
-    }
+// Sample position for something that happened at hardware tick 'tick'
+static uint32_t EventTimeAt(uint32_t tick)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t clock = engine.GetSampleClock();
+    uint32_t start_tick = block_start_tick;
+    if (!primask) __enable_irq();
+
+    // Negative for inputs scanned before the current block started
+    int32_t offset = (int32_t)((float)(int32_t)(tick - start_tick) * samples_per_tick);
+    uint32_t time = clock + offset + EVENT_LATENCY_BLOCKS * hw.seed.AudioBlockSize();
+    if ((int32_t)(time - clock) < 0) late_events++;
+    return time;
 }
 
-int main(void)
+static bool PostEngineEvent(ControlEventType type, uint32_t tick, int32_t inc = 0, bool btn = false, float pot = 0.0f)
 {
-    hw.Init();
-    screen.Init(hw.seed);
-    engine.Init(hw.sample_rate);
-    hw.seed.StartAudio(AudioCallback);
+    ControlEvent ev;
+    ev.time = EventTimeAt(tick);
+    ev.type = type;
+    ev.enc_inc = inc;
+    ev.button = btn;
+    ev.knob = pot;
+    return engine.PostEvent(ev);
+}
 
-    uint32_t last_ui_update = 0;
-    UiAction last_action = ACT_NONE;
-    uint32_t last_action_time = System::GetNow();
-    float    last_pot_stored = 0.0f;
+// --- MAIN LOOP TASKS ---
+// Task periods in microseconds (scheduler clock is tick_clock)
+static const uint32_t INPUT_PERIOD_US = 1000;
+static const uint32_t UI_PERIOD_US    = 33000;
+static const uint32_t IDLE_PERIOD_US  = 100000;
 
-    uint32_t enc_hold_start = 0; bool enc_hold_fired = false;
-    uint32_t btn_hold_start = 0; bool btn_hold_fired = false;
+// Reverb memory zeroed per BootTask run (samples)
+static const size_t REVERB_CLEAR_CHUNK = 4096;
 
-    while(1)
-    {
-        uint32_t primask = __get_PRIMASK();
-        __disable_irq();
-        int32_t inc = encoder_presses; encoder_presses = 0; 
-        bool btn = button_pressed; button_pressed = false;
-        float pot = pot_value;
-        if (!primask) __enable_irq();
-
-        uint32_t now = System::GetNow();
-
-        if (btn) { last_action = ACT_BTN; last_action_time = now; }
-        else if (inc != 0) { last_action = ACT_ENC; last_action_time = now; }
-        else if (fabs(pot - last_pot_stored) > 0.01f) { last_action = ACT_KNOB; last_action_time = now; last_pot_stored = pot; }
-
-        // HOLD ENCODER -> RANDOMIZE
-        if (hw.encoder.Pressed()) {
-            if (enc_hold_start == 0) enc_hold_start = now;
-            else if ((now - enc_hold_start > 1000) && !enc_hold_fired) {
-                engine.Randomize();
+static int control_task = -1;
+static int boot_task = -1;
+static bool screen_ready = false;
+
+static UiAction last_action = ACT_NONE;
+static uint32_t last_action_time = 0;
+static float    last_pot_stored = 0.0f;
+
+// Latest input snapshot, consumed by ControlTask. pending_tick is the scan
+// time of the newest input in it.
+static int32_t  pending_inc = 0;
+static bool     pending_btn = false;
+static float    pending_pot = 0.0f;
+static uint32_t pending_tick = 0;
+
+static uint32_t LaterTick(uint32_t a, uint32_t b) { return (int32_t)(a - b) > 0 ? a : b; }
+
+static TickClock tick_clock;
+static uint32_t ClockUs() { return tick_clock.Update(System::GetTick()); }
+
+// Millisecond logic (hold timers, idle, UI) uses System::GetNow(), which
+// wraps at 2^32 ms like the baseline expected; the scheduler's microsecond
+// time divided down would not.
+static void InputTask(uint32_t)
+{
+    // Drain debounced events published by the scan timer
+    int32_t inc = 0;
+    bool btn = false;
+    uint32_t tick = pending_tick;
+    InputEvent ev;
+    while (hw.input.PopEvent(ev)) {
+        if (ev.type == IN_ENC_TURN) { inc += ev.value; tick = LaterTick(tick, ev.tick); }
+        else if (ev.type == IN_BTN_PRESS) { btn = true; tick = LaterTick(tick, ev.tick); }
+    }
+    float pot = hw.input.GetPot();
+    if (pot != pending_pot) tick = LaterTick(tick, hw.input.GetPotTick());
+
+    uint32_t now = System::GetNow();
+    bool changed = (inc != 0) || btn || (pot != pending_pot);
+
+    if (btn) { last_action = ACT_BTN; last_action_time = now; }
+    else if (inc != 0) { last_action = ACT_ENC; last_action_time = now; }
+    else if (fabs(pot - last_pot_stored) > 0.01f) { last_action = ACT_KNOB; last_action_time = now; last_pot_stored = pot; }
+
+    // HOLD ENCODER -> RANDOMIZE
+    static uint32_t enc_hold_start = 0; static bool enc_hold_fired = false;
+    if (hw.input.EncoderPressed()) {
+        if (enc_hold_start == 0) enc_hold_start = now;
+        else if ((now - enc_hold_start > 1000) && !enc_hold_fired) {
+            // Queue full: stay unfired and retry on the next scan
+            if (PostEngineEvent(EVT_RANDOMIZE, System::GetTick())) {
                 enc_hold_fired = true;
                 last_action = ACT_ENC; last_action_time = now;
+                changed = true;
             }
-        } else { enc_hold_start = 0; enc_hold_fired = false; }
+        }
+    } else { enc_hold_start = 0; enc_hold_fired = false; }
 
-        // HOLD BUTTON -> RESET
-        if (hw.button.Pressed()) {
-            if (btn_hold_start == 0) btn_hold_start = now;
-            else if ((now - btn_hold_start > 1000) && !btn_hold_fired) {
-                engine.Reset();
+    // HOLD BUTTON -> RESET
+    static uint32_t btn_hold_start = 0; static bool btn_hold_fired = false;
+    if (hw.input.ButtonPressed()) {
+        if (btn_hold_start == 0) btn_hold_start = now;
+        else if ((now - btn_hold_start > 1000) && !btn_hold_fired) {
+            if (PostEngineEvent(EVT_RESET, System::GetTick())) {
                 btn_hold_fired = true;
                 last_action = ACT_BTN; last_action_time = now;
+                changed = true;
             }
-        } else { btn_hold_start = 0; btn_hold_fired = false; }
+        }
+    } else { btn_hold_start = 0; btn_hold_fired = false; }
+
+    if (changed) {
+        pending_inc += inc;
+        pending_btn |= btn;
+        pending_pot = pot;
+        pending_tick = tick;
+        scheduler.Signal(control_task);
+    }
+}
+
+static void ControlTask(uint32_t now_us)
+{
+    // Queue full: keep the input and run again once the audio side drains it
+    if (!PostEngineEvent(EVT_CONTROLS, pending_tick, pending_inc, pending_btn, pending_pot)) {
+        scheduler.Signal(control_task);
+        return;
+    }
+    pending_inc = 0;
+    pending_btn = false;
+}
 
-        // IDLE -> RANDOMIZE (Self Gen)
-        static bool idle_random_done = false;
-        if (now - last_action_time > 20000) {
-            if (!idle_random_done) { 
-                engine.Randomize(); 
+static void UiTask(uint32_t)
+{
+    if (!screen_ready) return;
+    uint32_t now = System::GetNow();
+    screen.DrawStatus(engine, last_action, now - last_action_time, cpu_meter.GetAvgCpuLoad());
+}
+
+// IDLE -> RANDOMIZE (Self Gen)
+static void IdleTask(uint32_t)
+{
+    static bool idle_random_done = false;
+    uint32_t now = System::GetNow();
+    if (now - last_action_time > 20000) {
+        if (!idle_random_done) { 
+            // Queue full: retry on the next idle check
+            if (PostEngineEvent(EVT_RANDOMIZE, System::GetTick())) {
                 idle_random_done = true; 
+                scheduler.Signal(control_task);
             }
-        } else { 
-            idle_random_done = false; 
         }
+    } else { 
+        idle_random_done = false; 
+    }
+}
 
-        engine.UpdateControls(inc, btn, pot);
+// Startup work that is not needed for sound, one step per run so the other
+// tasks keep running: display first, then reverb memory in chunks.
+static void BootTask(uint32_t now_us)
+{
+    if (!screen_ready) {
+        screen.Init(hw.seed); // Blocking I2C init + first Update
+        screen_ready = true;
+        BootMark(BOOT_DISPLAY);
+    }
+    else if (engine.InitStep(REVERB_CLEAR_CHUNK)) {
+        BootMark(BOOT_REVERB);
+        return;
+    }
+    scheduler.Signal(boot_task);
+}
 
-        if(now - last_ui_update > 33) {
-            last_ui_update = now;
-            screen.DrawStatus(engine, last_action, now - last_action_time);
-        }
+int main(void)
+{
+    // Only what the oscillator path needs runs before StartAudio
+    hw.Init();
+    BootMark(BOOT_HW);
+    mem::Init();
+    engine.Init(hw.sample_rate);
+    // A different Randomize sequence on every power-up: the hardware RNG,
+    // mixed with the boot tick in case it is not ready yet
+    Random::Init();
+    engine.SeedRandom(Random::GetValue() ^ System::GetTick());
+    cpu_meter.Init(hw.sample_rate, hw.seed.AudioBlockSize());
+    BootMark(BOOT_ENGINE);
+    samples_per_tick = hw.sample_rate / (float)System::GetTickFreq();
+    hw.seed.StartAudio(AudioCallback);
+    BootMark(BOOT_AUDIO_START);
+
+    last_action_time = System::GetNow();
+
+    tick_clock.Init(System::GetTickFreq() / 1000000, System::GetTick());
+    scheduler.Init(ClockUs);
+    scheduler.AddPeriodic(InputTask, INPUT_PERIOD_US, 1000);
+    control_task = scheduler.AddEvent(ControlTask, 2000);
+    scheduler.AddPeriodic(UiTask, UI_PERIOD_US, 15000);
+    scheduler.AddPeriodic(IdleTask, IDLE_PERIOD_US, 50000);
+    boot_task = scheduler.AddEvent(BootTask, 100000);
+    scheduler.Signal(boot_task);
+
+    while(1)
+    {
+        if (scheduler.RunPending()) continue;
+
+        // Nothing due: sleep until the next interrupt (SysTick, audio DMA,
+        // scan timer). Signals only come from tasks, so nothing can become
+        // pending between the check and the WFI.
+        if (!scheduler.HasSignalled()) __WFI();
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,240 @@
+// InputScanner fed recorded pin traces at 1 kHz: switch bounce, quadrature in
+// both directions, the button lockout, pot filtering/hysteresis and a stalled
+// main loop.
+#include "input.h"
+#include "test_util.h"
+#include <cmath>
+#include <vector>
+
+static const float SCAN_RATE = 1000.0f; // 1 scan per ms, as on the Seed
+
+// One trace segment: levels held for 'scans' scans (true = active)
+struct Segment {
+    uint32_t scans;
+    bool     enc_a, enc_b, enc_click, button;
+    float    pot;
+};
+
+struct Replay {
+    InputScanner scanner;
+    uint32_t now = 1000; // ms; the scan index doubles as the tick
+    std::vector<InputEvent> events;
+
+    Replay() { scanner.Init(SCAN_RATE); }
+
+    void Run(const Segment* trace, size_t count, bool drain = true) {
+        for (size_t i = 0; i < count; i++) {
+            for (uint32_t s = 0; s < trace[i].scans; s++) {
+                RawInputs raw = { trace[i].enc_a, trace[i].enc_b, trace[i].enc_click,
+                                  trace[i].button, trace[i].pot };
+                scanner.Scan(raw, now, now);
+                now++;
+                if (drain) Drain();
+            }
+        }
+    }
+    void Drain() {
+        InputEvent ev;
+        while (scanner.PopEvent(ev)) events.push_back(ev);
+    }
+    int Count(InputEventType type) const {
+        int n = 0;
+        for (const InputEvent& ev : events) if (ev.type == type) n += ev.value;
+        return n;
+    }
+    int Turns() const { return Count(IN_ENC_TURN); }
+};
+
+#define RUN(r, trace) (r).Run(trace, sizeof(trace) / sizeof(trace[0]))
+
+// Button closes with contact bounce, stays down, opens with bounce
+static const Segment BUTTON_BOUNCE[] = {
+    { 20, false, false, false, false, 0.5f },
+    {  1, false, false, false, true,  0.5f },
+    {  2, false, false, false, false, 0.5f },
+    {  1, false, false, false, true,  0.5f },
+    {  1, false, false, false, false, 0.5f },
+    { 50, false, false, false, true,  0.5f }, // Stable: press after 8 scans
+    {  1, false, false, false, false, 0.5f },
+    {  1, false, false, false, true,  0.5f },
+    {  3, false, false, false, false, 0.5f },
+    {  1, false, false, false, true,  0.5f },
+    { 50, false, false, false, false, 0.5f },
+};
+
+// A 5-scan glitch is shorter than the debounce window
+static const Segment BUTTON_GLITCH[] = {
+    { 20, false, false, false, false, 0.5f },
+    {  5, false, false, false, true,  0.5f },
+    { 20, false, false, false, false, 0.5f },
+};
+
+static void TestSwitchBounce()
+{
+    Replay r;
+    RUN(r, BUTTON_BOUNCE);
+    CHECK_EQ(r.Count(IN_BTN_PRESS), 1);
+    CHECK_EQ(r.Count(IN_BTN_RELEASE), 1);
+    CHECK(!r.scanner.ButtonPressed());
+    // Published on the 8th stable scan of the final closure (scan index 25+7)
+    CHECK_EQ(r.events[0].type, IN_BTN_PRESS);
+    CHECK_EQ(r.events[0].tick, 1000u + 25 + 7);
+
+    Replay g;
+    RUN(g, BUTTON_GLITCH);
+    CHECK(g.events.empty());
+}
+
+// Encoder detents, each quadrature state held for 2 scans. Clockwise: B goes
+// active first, then A (counted when A activates with B already active).
+static void AppendDetent(std::vector<Segment>& trace, int dir)
+{
+    bool cw = dir > 0;
+    trace.push_back({ 2, !cw, cw,  false, false, 0.5f });
+    trace.push_back({ 2, true, true, false, false, 0.5f });
+    trace.push_back({ 2, cw, !cw,  false, false, 0.5f });
+    trace.push_back({ 2, false, false, false, false, 0.5f });
+}
+
+static void TestQuadrature()
+{
+    std::vector<Segment> trace;
+    trace.push_back({ 5, false, false, false, false, 0.5f });
+    for (int i = 0; i < 4; i++) AppendDetent(trace, +1);
+
+    Replay cw;
+    cw.Run(trace.data(), trace.size());
+    CHECK_EQ(cw.Turns(), 4);
+    for (const InputEvent& ev : cw.events) CHECK(ev.type == IN_ENC_TURN && ev.value > 0);
+
+    trace.clear();
+    trace.push_back({ 5, false, false, false, false, 0.5f });
+    for (int i = 0; i < 3; i++) AppendDetent(trace, -1);
+
+    Replay ccw;
+    ccw.Run(trace.data(), trace.size());
+    CHECK_EQ(ccw.Turns(), -3);
+    for (const InputEvent& ev : ccw.events) CHECK(ev.type == IN_ENC_TURN && ev.value < 0);
+
+    // Back and forth nets out
+    trace.clear();
+    for (int i = 0; i < 6; i++) AppendDetent(trace, (i & 1) ? -1 : +1);
+    Replay both;
+    both.Run(trace.data(), trace.size());
+    CHECK_EQ(both.Turns(), 0);
+    CHECK_EQ((int)both.events.size(), 6);
+}
+
+// Presses 100 ms apart (second locked out), then one 300 ms later
+static const Segment BUTTON_LOCKOUT[] = {
+    {  20, false, false, false, false, 0.5f },
+    {  30, false, false, false, true,  0.5f }, // Press at 1027
+    {  70, false, false, false, false, 0.5f },
+    {  30, false, false, false, true,  0.5f }, // 100 ms later: locked out
+    { 270, false, false, false, false, 0.5f },
+    {  30, false, false, false, true,  0.5f }, // 400 ms after the first
+    {  20, false, false, false, false, 0.5f },
+};
+
+static void TestButtonLockout()
+{
+    Replay r;
+    RUN(r, BUTTON_LOCKOUT);
+    CHECK_EQ(r.Count(IN_BTN_PRESS), 2);
+    CHECK_EQ(r.Count(IN_BTN_RELEASE), 3); // Releases are not rate limited
+
+    std::vector<uint32_t> press_ticks;
+    for (const InputEvent& ev : r.events) if (ev.type == IN_BTN_PRESS) press_ticks.push_back(ev.tick);
+    CHECK_EQ(press_ticks.size(), 2u);
+    if (press_ticks.size() == 2) CHECK_EQ(press_ticks[1] - press_ticks[0], 400u);
+
+    // The encoder switch has no lockout
+    static const Segment CLICKS[] = {
+        { 20, false, false, false, false, 0.5f },
+        { 20, false, false, true,  false, 0.5f },
+        { 20, false, false, false, false, 0.5f },
+        { 20, false, false, true,  false, 0.5f },
+        { 20, false, false, false, false, 0.5f },
+    };
+    Replay c;
+    RUN(c, CLICKS);
+    CHECK_EQ(c.Count(IN_ENC_PRESS), 2);
+    CHECK_EQ(c.Count(IN_ENC_RELEASE), 2);
+}
+
+static void TestPotHysteresis()
+{
+    Replay r;
+    // Settle, then ADC noise of +/-0.001 (under the 0.002 hysteresis)
+    std::vector<Segment> trace;
+    trace.push_back({ 100, false, false, false, false, 0.300f });
+    for (int i = 0; i < 200; i++) {
+        trace.push_back({ 1, false, false, false, false, (i & 1) ? 0.301f : 0.299f });
+    }
+    r.Run(trace.data(), trace.size());
+    CHECK(fabsf(r.scanner.GetPot() - 0.3f) <= InputScanner::POT_HYSTERESIS);
+    uint32_t settled_tick = r.scanner.GetPotTick();
+    CHECK(settled_tick < 1000u + 100); // Noise never republished
+    CHECK(r.events.empty());           // The pot is not queued
+
+    // A real move is followed to within the hysteresis
+    static const Segment MOVE[] = { { 100, false, false, false, false, 0.8f } };
+    RUN(r, MOVE);
+    CHECK(fabsf(r.scanner.GetPot() - 0.8f) <= InputScanner::POT_HYSTERESIS);
+    CHECK(r.scanner.GetPotTick() > settled_tick);
+
+    // Smoothing: a single-scan spike barely moves the published value
+    float before = r.scanner.GetPot();
+    static const Segment SPIKE[] = {
+        { 1,  false, false, false, false, 0.0f },
+        { 50, false, false, false, false, 0.8f },
+    };
+    RUN(r, SPIKE);
+    CHECK(fabsf(r.scanner.GetPot() - before) <= 0.2f * 0.8f + InputScanner::POT_HYSTERESIS);
+}
+
+// Main loop stalled for 60 ms (blocking screen.Init) while the pot sweeps and
+// the button is pressed: the sweep takes no queue slots, the press arrives.
+static void TestStalledMainLoop()
+{
+    std::vector<Segment> trace;
+    for (int i = 0; i < 60; i++) {
+        trace.push_back({ 1, false, false, false, i >= 10 && i < 40, i / 60.0f });
+    }
+
+    Replay r;
+    r.Run(trace.data(), trace.size(), false); // No draining: main loop stalled
+    r.Drain();
+    CHECK_EQ((int)r.events.size(), 2);
+    CHECK_EQ(r.Count(IN_BTN_PRESS), 1);
+    CHECK_EQ(r.Count(IN_BTN_RELEASE), 1);
+    CHECK(r.scanner.GetPot() > 0.9f);
+
+    // Queue full with pending events: they arrive once the loop drains
+    Replay q;
+    std::vector<Segment> turns;
+    for (int i = 0; i < 40; i++) AppendDetent(turns, +1);
+    // 31 turn events fill the queue, the rest and the press stay pending
+    q.Run(turns.data(), turns.size(), false);
+    static const Segment PRESS[] = {
+        { 20, false, false, false, true,  0.5f },
+        { 20, false, false, false, false, 0.5f },
+    };
+    q.Run(PRESS, 2, false);
+    q.Drain();
+    static const Segment IDLE[] = { { 20, false, false, false, false, 0.5f } };
+    RUN(q, IDLE);
+    CHECK_EQ(q.Turns(), 40);
+    CHECK_EQ(q.Count(IN_BTN_PRESS), 1);
+    CHECK_EQ(q.Count(IN_BTN_RELEASE), 1);
+}
+
+int main()
+{
+    TestSwitchBounce();
+    TestQuadrature();
+    TestButtonLockout();
+    TestPotHysteresis();
+    TestStalledMainLoop();
+    return TEST_RESULT("input_test");
+}
@@ -0,0 +1,203 @@
+// A/B of StereoPhaser against the daisysp::Phaser pair it replaced, driven
+// exactly as the old Processing::Process did. For a sweep of PHASER values it
+// reports loudness, average octave-band response and cycles per sample, and
+// writes both versions of a slow PHASER sweep to BUILD_DIR for listening.
+//
+// The old pair is the stub model in stubs/daisysp.h, not DaisySP itself, so
+// its figures are indicative. Note that the old code called SetFreq(), which
+// in DaisySP sets the allpass delay, not the LFO rate (that stays at the
+// default), so the two are expected to sound quite different; the band
+// column shows by how much.
+//
+// Gates: the new phaser must cost under half of the old pair, keep the level
+// within LOUDNESS_TOL_DB of the dry signal and stay bounded. Loudness is not
+// gated against the old pair, which loses ~5 dB to its averaged engines.
+// Tonal balance is: after matching levels, no octave band may differ from
+// the old pair by more than BAND_TOL_DB (measured worst case 4.4 dB, at
+// PHASER 0.25 around 250 Hz). A tighter figure needs a revoiced phaser.
+#include "render.h"
+#include "test_util.h"
+#include <string>
+
+#ifndef BUILD_DIR
+#define BUILD_DIR "build"
+#endif
+
+static const float  AB_SECONDS      = 2.0f;
+static const double LOUDNESS_TOL_DB = 3.0;
+static const double COST_RATIO_MAX  = 0.5;
+static const double BAND_TOL_DB     = 5.0;
+
+// Deterministic test signal: 110 Hz saw plus white noise
+struct TestSignal {
+    uint32_t rng = 12345;
+    float phase = 0.0f;
+    float Next() {
+        rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+        float noise = (rng >> 8) * (2.0f / 16777216.0f) - 1.0f;
+        phase += 110.0f / RENDER_SR;
+        if (phase >= 1.0f) phase -= 1.0f;
+        return 0.3f * (2.0f * phase - 1.0f) + 0.2f * noise;
+    }
+};
+
+struct OldPhaser {
+    daisysp::Phaser l, r;
+    void Init() { l.Init(RENDER_SR); r.Init(RENDER_SR); }
+    // As in Processing::Process before the StereoPhaser change
+    void Process(float p, float& out_l, float& out_r) {
+        l.SetLfoDepth(p); r.SetLfoDepth(p);
+        l.SetFreq(0.5f + (p * 2.0f));
+        r.SetFreq(0.4f + (p * 2.1f));
+        out_l = l.Process(out_l); out_r = r.Process(out_r);
+    }
+};
+
+// Octave bands 62.5 Hz .. 16 kHz (RBJ band-pass, Q = sqrt(2))
+static const int NUM_BANDS = 9;
+
+struct BandMeter {
+    float b0[NUM_BANDS], a1[NUM_BANDS], a2[NUM_BANDS];
+    float x1[NUM_BANDS], x2[NUM_BANDS], y1[NUM_BANDS], y2[NUM_BANDS];
+    double energy[NUM_BANDS];
+
+    void Init() {
+        for (int b = 0; b < NUM_BANDS; b++) {
+            float fc = 62.5f * (float)(1 << b);
+            float w0 = TWOPI_F * fc / RENDER_SR;
+            float alpha = sinf(w0) / (2.0f * 1.41421356f);
+            float a0 = 1.0f + alpha;
+            b0[b] = alpha / a0;
+            a1[b] = -2.0f * cosf(w0) / a0;
+            a2[b] = (1.0f - alpha) / a0;
+            x1[b] = x2[b] = y1[b] = y2[b] = 0.0f;
+            energy[b] = 0.0;
+        }
+    }
+    void Process(float x) {
+        for (int b = 0; b < NUM_BANDS; b++) {
+            float y = b0[b] * (x - x2[b]) - a1[b] * y1[b] - a2[b] * y2[b];
+            x2[b] = x1[b]; x1[b] = x;
+            y2[b] = y1[b]; y1[b] = y;
+            energy[b] += (double)y * y;
+        }
+    }
+};
+
+static double Db(double ratio) { return ratio > 0.0 ? 10.0 * log10(ratio) : -200.0; }
+
+int main()
+{
+    const float sweep[] = { 0.05f, 0.25f, 0.5f, 0.75f, 1.0f };
+    const size_t total = (size_t)(AB_SECONDS * RENDER_SR);
+
+    TestSignal dry_sig;
+    std::vector<float> dry(total);
+    for (size_t i = 0; i < total; i++) dry[i] = dry_sig.Next();
+    const double dry_db = RmsDb(dry);
+
+    std::printf("dry %.1f dBFS\n", dry_db);
+    std::printf("PHASER  loud old/new dB (L, R)       cyc/smp old/new   band new-old dB, level matched (62.5 Hz .. 16 kHz)\n");
+
+    for (float p : sweep) {
+        OldPhaser* old_ph = new OldPhaser();
+        StereoPhaser* new_ph = new StereoPhaser();
+        old_ph->Init();
+        new_ph->Init(RENDER_SR);
+
+        StereoBuffer old_out, new_out;
+        old_out.l = old_out.r = new_out.l = new_out.r = dry;
+
+        uint64_t old_cycles = 0, new_cycles = 0;
+        for (size_t pos = 0; pos < total; pos += RENDER_BLOCK) {
+            uint64_t t0 = ReadCycles();
+            for (size_t i = pos; i < pos + RENDER_BLOCK; i++) old_ph->Process(p, old_out.l[i], old_out.r[i]);
+            uint64_t t1 = ReadCycles();
+            // Control rate update per block, as ProcessBlock does
+            new_ph->SetParams(p, 0.5f + (p * 2.0f), RENDER_BLOCK);
+            for (size_t i = pos; i < pos + RENDER_BLOCK; i++) new_ph->Process(new_out.l[i], new_out.r[i]);
+            uint64_t t2 = ReadCycles();
+            old_cycles += t1 - t0;
+            new_cycles += t2 - t1;
+        }
+
+        BandMeter m_old, m_new;
+        m_old.Init(); m_new.Init();
+        double peak = 0.0;
+        for (size_t i = 0; i < total; i++) {
+            m_old.Process(old_out.l[i] + old_out.r[i]);
+            m_new.Process(new_out.l[i] + new_out.r[i]);
+            peak = fmax(peak, fmax(fabs(new_out.l[i]), fabs(new_out.r[i])));
+        }
+
+        double old_l = RmsDb(old_out.l), old_r = RmsDb(old_out.r);
+        double new_l = RmsDb(new_out.l), new_r = RmsDb(new_out.r);
+        double old_cps = (double)old_cycles / total, new_cps = (double)new_cycles / total;
+
+        std::printf("%5.2f   %6.1f/%6.1f  %6.1f/%6.1f   %6.1f/%6.1f    ",
+                    p, old_l, new_l, old_r, new_r, old_cps, new_cps);
+        double band_diff[NUM_BANDS], mean_diff = 0.0;
+        for (int b = 0; b < NUM_BANDS; b++) {
+            band_diff[b] = Db(m_new.energy[b] / m_old.energy[b]);
+            mean_diff += band_diff[b] / NUM_BANDS;
+        }
+        double worst_band = 0.0;
+        for (int b = 0; b < NUM_BANDS; b++) {
+            band_diff[b] -= mean_diff;
+            worst_band = fmax(worst_band, fabs(band_diff[b]));
+            std::printf(" %+5.1f", band_diff[b]);
+        }
+        std::printf("\n");
+
+        if (worst_band > BAND_TOL_DB) {
+            std::printf("FAIL PHASER %.2f: tonal balance differs by %.1f dB (tol %.1f)\n", p, worst_band, BAND_TOL_DB);
+            test_failures++;
+        }
+
+        if (fabs(new_l - dry_db) > LOUDNESS_TOL_DB || fabs(new_r - dry_db) > LOUDNESS_TOL_DB) {
+            std::printf("FAIL PHASER %.2f: level differs from dry by more than %.1f dB\n", p, LOUDNESS_TOL_DB);
+            test_failures++;
+        }
+        if (new_cps > old_cps * COST_RATIO_MAX) {
+            std::printf("FAIL PHASER %.2f: new phaser costs %.0f%% of the old pair\n", p, 100.0 * new_cps / old_cps);
+            test_failures++;
+        }
+        CHECK(peak < 2.0);
+
+        delete old_ph;
+        delete new_ph;
+    }
+
+    // Listening render: PHASER swept 0 -> 1 over 10 s, old and new
+    {
+        const size_t n = (size_t)(10.0f * RENDER_SR);
+        OldPhaser* old_ph = new OldPhaser();
+        StereoPhaser* new_ph = new StereoPhaser();
+        old_ph->Init();
+        new_ph->Init(RENDER_SR);
+        TestSignal sig;
+        StereoBuffer a, b;
+        a.l.resize(n); a.r.resize(n); b.l.resize(n); b.r.resize(n);
+        for (size_t pos = 0; pos < n; pos += RENDER_BLOCK) {
+            float p = (float)pos / n;
+            new_ph->SetParams(p, 0.5f + (p * 2.0f), RENDER_BLOCK);
+            for (size_t i = pos; i < pos + RENDER_BLOCK; i++) {
+                float x = sig.Next();
+                a.l[i] = a.r[i] = b.l[i] = b.r[i] = x;
+                old_ph->Process(p, a.l[i], a.r[i]);
+                new_ph->Process(b.l[i], b.r[i]);
+            }
+        }
+        for (const char* name : { "old", "new" }) {
+            std::string path = std::string(BUILD_DIR) + "/phaser_ab_" + name + ".wav";
+            if (!WriteWav(path.c_str(), name[0] == 'o' ? a : b)) {
+                std::printf("FAIL cannot write %s\n", path.c_str());
+                test_failures++;
+            }
+        }
+        delete old_ph;
+        delete new_ph;
+    }
+
+    return TEST_RESULT("phaser_ab");
+}
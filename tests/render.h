@@ -0,0 +1,178 @@
+#pragma once
+// --- HOST RENDER HARNESS ---
+// Offline rendering of the engine (or any block kernel) with a cycle counter,
+// 16-bit WAV I/O for reference renders and a null-test comparison.
+#include "processing.h"
+#include "mem.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static const float  RENDER_SR    = 48000.0f;
+static const size_t RENDER_BLOCK = 48; // Same as the Seed
+
+// TSC cycles on x86; elsewhere nanoseconds (treat budgets as approximate)
+static inline uint64_t ReadCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct StereoBuffer {
+    std::vector<float> l, r;
+    size_t Size() const { return l.size(); }
+};
+
+// Fixed workload (sine + one-pole cascade, roughly the engine's mix of
+// transcendental and filter math) that never changes with the engine. Timed
+// between engine blocks, it turns absolute cycles into a cost ratio that host
+// clock speed, turbo and load mostly cancel out of.
+static inline uint64_t RenderReference(size_t samples)
+{
+    static volatile float sink __attribute__((unused));
+    static float state[8] = {};
+    static float phase = 0.0f;
+    uint64_t start = ReadCycles();
+    for (size_t i = 0; i < samples; i++) {
+        phase += 0.0131f;
+        if (phase > TWOPI_F) phase -= TWOPI_F;
+        float x = sinf(phase);
+        for (float& s : state) { s += 0.1f * (x - s); x = s; }
+    }
+    sink = state[7];
+    return ReadCycles() - start;
+}
+
+// Renders 'seconds' of a freshly initialised engine with 'events' posted up
+// front (timestamps are sample positions). Deferred init (reverb memory) is
+// completed before the first block. Returns the cycles spent in ProcessBlock;
+// with 'reference_cycles', RenderReference runs for one block after each
+// engine block and its cycles are added there.
+static inline uint64_t RenderEngine(const std::vector<ControlEvent>& events, uint32_t seed,
+                                    float seconds, StereoBuffer& out,
+                                    uint64_t* reference_cycles = nullptr)
+{
+    mem::Init();
+    Processing* engine = new Processing();
+    engine->Init(RENDER_SR);
+    while (!engine->InitStep(4096)) {}
+    if (seed) engine->SeedRandom(seed);
+
+    size_t total = (size_t)(seconds * RENDER_SR);
+    total -= total % RENDER_BLOCK;
+    out.l.assign(total, 0.0f);
+    out.r.assign(total, 0.0f);
+
+    size_t next_event = 0;
+    uint64_t cycles = 0;
+    for (size_t pos = 0; pos < total; pos += RENDER_BLOCK) {
+        // Keep the queue topped up with events due in the next few blocks,
+        // as the main loop would
+        while (next_event < events.size() && events[next_event].time < pos + 4 * RENDER_BLOCK) {
+            if (!engine->PostEvent(events[next_event])) break;
+            next_event++;
+        }
+        uint64_t start = ReadCycles();
+        engine->ProcessBlock(&out.l[pos], &out.r[pos], RENDER_BLOCK);
+        cycles += ReadCycles() - start;
+        if (reference_cycles) *reference_cycles += RenderReference(RENDER_BLOCK);
+    }
+
+    delete engine;
+    return cycles;
+}
+
+// --- WAV (16-bit PCM, stereo) ---
+
+static inline void PutLe(FILE* f, uint32_t v, int bytes)
+{
+    for (int i = 0; i < bytes; i++) fputc((v >> (8 * i)) & 0xff, f);
+}
+
+static inline bool WriteWav(const char* path, const StereoBuffer& buf)
+{
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    uint32_t data_bytes = (uint32_t)(buf.Size() * 4);
+    fwrite("RIFF", 1, 4, f); PutLe(f, 36 + data_bytes, 4);
+    fwrite("WAVEfmt ", 1, 8, f);
+    PutLe(f, 16, 4); PutLe(f, 1, 2); PutLe(f, 2, 2);
+    PutLe(f, (uint32_t)RENDER_SR, 4); PutLe(f, (uint32_t)RENDER_SR * 4, 4);
+    PutLe(f, 4, 2); PutLe(f, 16, 2);
+    fwrite("data", 1, 4, f); PutLe(f, data_bytes, 4);
+    for (size_t i = 0; i < buf.Size(); i++) {
+        for (float s : { buf.l[i], buf.r[i] }) {
+            float c = s < -1.0f ? -1.0f : (s > 1.0f ? 1.0f : s);
+            PutLe(f, (uint32_t)(uint16_t)(int16_t)lrintf(c * 32767.0f), 2);
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+// Reads files written by WriteWav (canonical 44-byte header)
+static inline bool ReadWav(const char* path, StereoBuffer& buf)
+{
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+    unsigned char hdr[44];
+    bool ok = fread(hdr, 1, 44, f) == 44 && memcmp(hdr, "RIFF", 4) == 0
+              && memcmp(hdr + 36, "data", 4) == 0 && hdr[22] == 2 && hdr[34] == 16;
+    if (!ok) { fclose(f); return false; }
+    uint32_t data_bytes = hdr[40] | (hdr[41] << 8) | (hdr[42] << 16) | ((uint32_t)hdr[43] << 24);
+    size_t frames = data_bytes / 4;
+    std::vector<int16_t> pcm(frames * 2);
+    ok = fread(pcm.data(), 2, pcm.size(), f) == pcm.size();
+    fclose(f);
+    buf.l.resize(frames);
+    buf.r.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        buf.l[i] = pcm[2 * i] / 32767.0f;
+        buf.r[i] = pcm[2 * i + 1] / 32767.0f;
+    }
+    return ok;
+}
+
+// --- NULL TEST ---
+
+struct NullResult {
+    double max_abs;      // Largest sample difference
+    double residual_db;  // RMS of the difference, dBFS
+    bool   length_ok;
+};
+
+static inline NullResult NullTest(const StereoBuffer& render, const StereoBuffer& ref)
+{
+    NullResult res = { 0.0, -200.0, render.Size() == ref.Size() };
+    if (!res.length_ok) return res;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < render.Size(); i++) {
+        double dl = fabs((double)render.l[i] - ref.l[i]);
+        double dr = fabs((double)render.r[i] - ref.r[i]);
+        if (dl > res.max_abs) res.max_abs = dl;
+        if (dr > res.max_abs) res.max_abs = dr;
+        sum += dl * dl + dr * dr;
+    }
+    double rms = sqrt(sum / (2.0 * render.Size()));
+    res.residual_db = rms > 0.0 ? 20.0 * log10(rms) : -200.0;
+    return res;
+}
+
+static inline double RmsDb(const std::vector<float>& x)
+{
+    double sum = 0.0;
+    for (float s : x) sum += (double)s * s;
+    double rms = x.empty() ? 0.0 : sqrt(sum / x.size());
+    return rms > 0.0 ? 20.0 * log10(rms) : -200.0;
+}
@@ -0,0 +1,270 @@
+// Golden-render regression suite: renders a fixed set of patches through the
+// engine, null-tests them against tests/golden/*.wav and enforces a
+// cycles-per-sample budget per patch.
+//
+//   render_test            check renders and budgets
+//   render_test --costs    print costs only (to re-derive budgets)
+//   render_test --update   rewrite the references (review the diff by ear!)
+#include "render.h"
+#include "test_util.h"
+#include <algorithm>
+#include <string>
+
+#ifndef GOLDEN_DIR
+#define GOLDEN_DIR "golden"
+#endif
+
+static const float RENDER_SECONDS = 2.0f;
+static const int   COST_RUNS = 7;
+
+enum PatchKind {
+    PATCH_RESET,      // Reset defaults
+    PATCH_PARAM,      // One SynthParam at an extreme, rest at defaults
+    PATCH_RANDOM,     // SeedRandom(seed) + Randomize
+    PATCH_AUTOMATION  // FILTER swept by knob events every 480 samples
+};
+
+struct PatchSpec {
+    const char* name;
+    PatchKind   kind;
+    int         param;   // PATCH_PARAM
+    float       value;   // PATCH_PARAM: knob position
+    uint32_t    seed;    // PATCH_RANDOM
+    double      max_abs; // Null-test tolerance (largest sample difference)
+    double      budget;  // Cost: engine cycles / reference kernel cycles
+};
+
+// Tolerance floor is the 16-bit reference quantisation (~1.5e-5). Budgets are
+// cost ratios (see COST below), 1.25x the median of four `--costs` runs;
+// run to run the ratios stay within ~6%, so a 25% regression fails.
+static const PatchSpec PATCHES[] = {
+    { "reset",          PATCH_RESET, 0, 0, 0, 1e-4, 7.9 },
+
+    { "freq_min",       PATCH_PARAM, PARAM_FREQ,       0.0f, 0, 1e-4, 7.9 },
+    { "freq_max",       PATCH_PARAM, PARAM_FREQ,       1.0f, 0, 1e-4, 8.2 },
+    { "wave_min",       PATCH_PARAM, PARAM_WAVEFORM,   0.0f, 0, 1e-4, 8.0 },
+    { "wave_max",       PATCH_PARAM, PARAM_WAVEFORM,   1.0f, 0, 1e-4, 6.9 },
+    { "amp_min",        PATCH_PARAM, PARAM_AMP,        0.0f, 0, 1e-4, 8.0 },
+    { "amp_max",        PATCH_PARAM, PARAM_AMP,        1.0f, 0, 1e-4, 8.0 },
+    { "filter_min",     PATCH_PARAM, PARAM_FILTER,     0.0f, 0, 1e-4, 8.0 },
+    { "filter_max",     PATCH_PARAM, PARAM_FILTER,     1.0f, 0, 1e-4, 8.0 },
+    { "dist_min",       PATCH_PARAM, PARAM_DIST,       0.0f, 0, 1e-4, 8.0 },
+    { "dist_max",       PATCH_PARAM, PARAM_DIST,       1.0f, 0, 1e-4, 10.9 },
+    { "phaser_min",     PATCH_PARAM, PARAM_PHASER,     0.0f, 0, 1e-4, 8.0 },
+    { "phaser_max",     PATCH_PARAM, PARAM_PHASER,     1.0f, 0, 1e-4, 8.5 },
+    { "detune_min",     PATCH_PARAM, PARAM_DETUNE,     0.0f, 0, 1e-4, 8.1 },
+    { "detune_max",     PATCH_PARAM, PARAM_DETUNE,     1.0f, 0, 1e-4, 8.3 },
+    { "rev_amt_min",    PATCH_PARAM, PARAM_REV_AMT,    0.0f, 0, 1e-4, 8.0 },
+    { "rev_amt_max",    PATCH_PARAM, PARAM_REV_AMT,    1.0f, 0, 1e-4, 20.8 },
+    { "rev_len_min",    PATCH_PARAM, PARAM_REV_LEN,    0.0f, 0, 1e-4, 8.1 },
+    { "rev_len_max",    PATCH_PARAM, PARAM_REV_LEN,    1.0f, 0, 1e-4, 8.1 },
+    { "rev_tone_min",   PATCH_PARAM, PARAM_REV_TONE,   0.0f, 0, 1e-4, 7.9 },
+    { "rev_tone_max",   PATCH_PARAM, PARAM_REV_TONE,   1.0f, 0, 1e-4, 8.0 },
+    { "wob_amt_min",    PATCH_PARAM, PARAM_WOB_AMT,    0.0f, 0, 1e-4, 8.0 },
+    { "wob_amt_max",    PATCH_PARAM, PARAM_WOB_AMT,    1.0f, 0, 1e-4, 8.0 },
+    { "wob_spd_min",    PATCH_PARAM, PARAM_WOB_SPD,    0.0f, 0, 1e-4, 7.9 },
+    { "wob_spd_max",    PATCH_PARAM, PARAM_WOB_SPD,    1.0f, 0, 1e-4, 8.0 },
+    { "sweep_amt_min",  PATCH_PARAM, PARAM_SWEEP_AMT,  0.0f, 0, 1e-4, 8.0 },
+    { "sweep_amt_max",  PATCH_PARAM, PARAM_SWEEP_AMT,  1.0f, 0, 1e-4, 8.5 },
+    { "sweep_rate_min", PATCH_PARAM, PARAM_SWEEP_RATE, 0.0f, 0, 1e-4, 8.0 },
+    { "sweep_rate_max", PATCH_PARAM, PARAM_SWEEP_RATE, 1.0f, 0, 1e-4, 8.0 },
+
+    { "random_1",       PATCH_RANDOM, 0, 0, 1,    1e-4, 24.1 },
+    { "random_2",       PATCH_RANDOM, 0, 0, 2,    1e-4, 24.9 },
+    { "random_3",       PATCH_RANDOM, 0, 0, 3,    1e-4, 25.2 },
+    { "random_1234",    PATCH_RANDOM, 0, 0, 1234, 1e-4, 24.0 },
+
+    { "filter_automation", PATCH_AUTOMATION, 0, 0, 0, 1e-4, 8.1 },
+};
+
+static ControlEvent MakeEvent(uint32_t time, ControlEventType type, int32_t inc = 0, float knob = 0.0f)
+{
+    ControlEvent ev;
+    ev.time = time;
+    ev.type = type;
+    ev.enc_inc = inc;
+    ev.button = false;
+    ev.knob = knob;
+    return ev;
+}
+
+// Same path as the hardware: select with the encoder (locks the knob at
+// 0.5), then move the knob far enough to unlock and set the value.
+static void AddSetParam(std::vector<ControlEvent>& events, uint32_t time, int from, int param, float value)
+{
+    events.push_back(MakeEvent(time, EVT_CONTROLS, param - from, 0.5f));
+    events.push_back(MakeEvent(time, EVT_CONTROLS, 0, value));
+}
+
+static std::vector<ControlEvent> BuildEvents(const PatchSpec& p)
+{
+    std::vector<ControlEvent> events;
+    switch (p.kind) {
+        case PATCH_RESET:
+            events.push_back(MakeEvent(0, EVT_RESET));
+            break;
+        case PATCH_PARAM:
+            AddSetParam(events, 0, PARAM_FREQ, p.param, p.value);
+            break;
+        case PATCH_RANDOM:
+            events.push_back(MakeEvent(0, EVT_RANDOMIZE));
+            break;
+        case PATCH_AUTOMATION: {
+            AddSetParam(events, 0, PARAM_FREQ, PARAM_FILTER, 0.0f);
+            size_t total = (size_t)(RENDER_SECONDS * RENDER_SR);
+            for (uint32_t t = 480; t < total; t += 480) {
+                events.push_back(MakeEvent(t, EVT_CONTROLS, 0, (float)t / total));
+            }
+        } break;
+    }
+    return events;
+}
+
+// --- COST ---
+// Costs are engine cycles divided by cycles of RenderReference run between
+// blocks in the same render (median of COST_RUNS), so they hold across hosts
+// and host load; absolute cycles are printed for information only.
+
+// Median over COST_RUNS of render(&reference_cycles) / reference_cycles
+template <typename RenderFn>
+static double MedianCostRatio(RenderFn render)
+{
+    double ratios[COST_RUNS];
+    for (int r = 0; r < COST_RUNS; r++) {
+        uint64_t ref = 0;
+        uint64_t cycles = render(&ref);
+        ratios[r] = (double)cycles / (double)ref;
+    }
+    std::sort(ratios, ratios + COST_RUNS);
+    return ratios[COST_RUNS / 2];
+}
+
+// Per-kernel benchmarks: the inner loops the engine budgets are most
+// sensitive to, with their control-rate update every block, so a lost
+// optimisation (per-sample coefficient math) shows up undiluted.
+static uint64_t MorphFilterKernel(uint64_t* reference_cycles)
+{
+    // Static: fixed addresses (page offsets) from run to run, see KERNELS
+    static MorphFilter filter;
+    static float l[RENDER_BLOCK], r[RENDER_BLOCK];
+    MorphFilter* f = &filter;
+    f->Init(RENDER_SR);
+    size_t total = (size_t)(RENDER_SECONDS * RENDER_SR);
+    uint64_t cycles = 0;
+    for (size_t pos = 0; pos < total; pos += RENDER_BLOCK) {
+        for (size_t i = 0; i < RENDER_BLOCK; i++) l[i] = r[i] = ((pos + i) & 63) * (1.0f / 32.0f) - 1.0f;
+        uint64_t start = ReadCycles();
+        f->SetMorph((float)pos / total, RENDER_BLOCK); // Knob moving every block
+        for (size_t i = 0; i < RENDER_BLOCK; i++) f->Process(l[i], r[i]);
+        cycles += ReadCycles() - start;
+        *reference_cycles += RenderReference(RENDER_BLOCK);
+    }
+    return cycles;
+}
+
+static uint64_t StereoPhaserKernel(uint64_t* reference_cycles)
+{
+    static StereoPhaser phaser;
+    static float l[RENDER_BLOCK], r[RENDER_BLOCK];
+    StereoPhaser* ph = &phaser;
+    ph->Init(RENDER_SR);
+    size_t total = (size_t)(RENDER_SECONDS * RENDER_SR);
+    uint64_t cycles = 0;
+    for (size_t pos = 0; pos < total; pos += RENDER_BLOCK) {
+        for (size_t i = 0; i < RENDER_BLOCK; i++) l[i] = r[i] = ((pos + i) & 63) * (1.0f / 32.0f) - 1.0f;
+        uint64_t start = ReadCycles();
+        float depth = (float)pos / total;
+        ph->SetParams(depth, 0.5f + depth * 2.0f, RENDER_BLOCK);
+        for (size_t i = 0; i < RENDER_BLOCK; i++) ph->Process(l[i], r[i]);
+        cycles += ReadCycles() - start;
+        *reference_cycles += RenderReference(RENDER_BLOCK);
+    }
+    return cycles;
+}
+
+struct KernelSpec {
+    const char* name;
+    uint64_t  (*render)(uint64_t* reference_cycles);
+    double      budget; // Cost ratio, as PatchSpec::budget
+};
+
+// morph_filter: 1.3x its median (0.52). stereo_phaser is latency bound and
+// swings between ~0.8 and ~1.1 of the reference with host state, so its budget
+// is 1.15x the slow mode; per-sample coefficient math costs 3-5x either way.
+static const KernelSpec KERNELS[] = {
+    { "morph_filter",  MorphFilterKernel,  0.70 },
+    { "stereo_phaser", StereoPhaserKernel, 1.30 },
+};
+
+int main(int argc, char** argv)
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+    bool update = mode == "--update";
+    bool costs_only = mode == "--costs";
+
+    for (const PatchSpec& p : PATCHES) {
+        std::vector<ControlEvent> events = BuildEvents(p);
+        uint32_t seed = p.kind == PATCH_RANDOM ? p.seed : 0;
+
+        StereoBuffer out;
+        uint64_t cycles = RenderEngine(events, seed, RENDER_SECONDS, out);
+        double cps = (double)cycles / out.Size();
+        double cost = MedianCostRatio([&](uint64_t* ref) {
+            StereoBuffer scratch;
+            return RenderEngine(events, seed, RENDER_SECONDS, scratch, ref);
+        });
+
+        if (costs_only) {
+            std::printf("%-18s cost %6.2f (budget %5.2f, x%.2f)  %7.1f cyc/smp\n",
+                        p.name, cost, p.budget, p.budget / cost, cps);
+            continue;
+        }
+
+        std::string path = std::string(GOLDEN_DIR) + "/" + p.name + ".wav";
+
+        if (update) {
+            if (!WriteWav(path.c_str(), out)) {
+                std::printf("FAIL cannot write %s\n", path.c_str());
+                test_failures++;
+            }
+            std::printf("%-18s %6.1f dBFS  cost %6.2f (budget %5.2f)\n",
+                        p.name, (RmsDb(out.l) + RmsDb(out.r)) * 0.5, cost, p.budget);
+            continue;
+        }
+
+        StereoBuffer ref;
+        if (!ReadWav(path.c_str(), ref)) {
+            std::printf("FAIL %-18s missing reference %s\n", p.name, path.c_str());
+            test_failures++;
+            continue;
+        }
+
+        // Compare against what the reference can represent
+        StereoBuffer quantised = out;
+        for (size_t i = 0; i < quantised.Size(); i++) {
+            quantised.l[i] = lrintf(fmaxf(-1.0f, fminf(1.0f, out.l[i])) * 32767.0f) / 32767.0f;
+            quantised.r[i] = lrintf(fmaxf(-1.0f, fminf(1.0f, out.r[i])) * 32767.0f) / 32767.0f;
+        }
+        NullResult nr = NullTest(quantised, ref);
+
+        bool null_ok = nr.length_ok && nr.max_abs <= p.max_abs;
+        bool cost_ok = cost <= p.budget;
+        std::printf("%-4s %-18s null max %.2e (tol %.0e) residual %7.1f dB  cost %6.2f (budget %5.2f) %6.1f cyc/smp%s\n",
+                    (null_ok && cost_ok) ? "ok" : "FAIL", p.name, nr.max_abs, p.max_abs,
+                    nr.residual_db, cost, p.budget, cps, cost_ok ? "" : "  OVER BUDGET");
+        if (!null_ok) test_failures++;
+        if (!cost_ok) test_failures++;
+    }
+
+    if (!update) {
+        for (const KernelSpec& k : KERNELS) {
+            double cost = MedianCostRatio(k.render);
+            bool cost_ok = costs_only || cost <= k.budget;
+            std::printf("%-4s %-18s cost %6.2f (budget %5.2f, x%.2f)%s\n", cost_ok ? "ok" : "FAIL",
+                        k.name, cost, k.budget, k.budget / cost, cost_ok ? "" : "  OVER BUDGET");
+            if (!cost_ok) test_failures++;
+        }
+    }
+
+    return TEST_RESULT("render_test");
+}
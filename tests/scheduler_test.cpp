@@ -0,0 +1,256 @@
+// Scheduler on a virtual clock: cadence, overrun handling, event signalling,
+// clock wrap and TickClock over a counter that does not wrap at 2^32 us.
+#include "scheduler.h"
+#include "test_util.h"
+
+static uint32_t virtual_now = 0;
+static uint32_t VirtualClock() { return virtual_now; }
+
+static int      runs_a = 0;
+static uint32_t last_now_a = 0;
+static void TaskA(uint32_t now) { runs_a++; last_now_a = now; }
+
+static int runs_b = 0;
+static void TaskB(uint32_t) { runs_b++; }
+
+// Takes 250 us of virtual time
+static void SlowTask(uint32_t) { virtual_now += 250; }
+
+static Scheduler* resignal_sched = nullptr;
+static int resignal_id = -1;
+static int resignal_runs = 0;
+static void ResignalTask(uint32_t)
+{
+    if (++resignal_runs < 3) resignal_sched->Signal(resignal_id);
+}
+
+static void Reset(uint32_t start)
+{
+    virtual_now = start;
+    runs_a = runs_b = 0;
+    last_now_a = 0;
+}
+
+// Advance the clock in 'step' increments, running the scheduler each time
+static void RunFor(Scheduler& s, uint32_t duration, uint32_t step)
+{
+    for (uint32_t t = 0; t < duration; t += step) {
+        virtual_now += step;
+        s.RunPending();
+    }
+}
+
+static void TestPeriodicCadence()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    int id = s.AddPeriodic(TaskA, 1000, 100);
+    CHECK(id >= 0);
+
+    RunFor(s, 10000, 100);
+    CHECK_EQ(runs_a, 10);
+    CHECK_EQ(last_now_a, 10000);
+    CHECK_EQ(s.GetTask(id).runs, 10);
+    CHECK_EQ(s.GetTask(id).missed, 0);
+    CHECK_EQ(s.GetTask(id).max_lateness_us, 0);
+
+    // Not due again until the next period
+    CHECK(!s.RunPending());
+}
+
+static void TestOverrunSkipsBacklog()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    int id = s.AddPeriodic(TaskA, 1000, 200);
+
+    // Main loop stalled for 4.5 periods: run once, not four times
+    virtual_now = 4500;
+    CHECK(s.RunPending());
+    CHECK(!s.RunPending());
+    CHECK_EQ(runs_a, 1);
+    CHECK_EQ(s.GetTask(id).missed, 1);
+    CHECK_EQ(s.GetTask(id).max_lateness_us, 3500);
+
+    // Cadence restarts from the late run
+    CHECK_EQ(s.TimeUntilNext(), 1000);
+    virtual_now = 5499;
+    CHECK(!s.RunPending());
+    virtual_now = 5500;
+    CHECK(s.RunPending());
+    CHECK_EQ(runs_a, 2);
+    CHECK_EQ(s.GetTask(id).missed, 1);
+}
+
+static void TestRuntimeMeasured()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    int id = s.AddPeriodic(SlowTask, 1000, 100);
+    virtual_now = 1000;
+    s.RunPending();
+    CHECK_EQ(s.GetTask(id).max_runtime_us, 250);
+}
+
+static void TestSignalCoalesces()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    int id = s.AddEvent(TaskB, 400);
+
+    CHECK(!s.HasSignalled());
+    CHECK(!s.RunPending());
+
+    virtual_now = 100;
+    s.Signal(id);
+    virtual_now = 300;
+    s.Signal(id); // Already pending: keeps the t=100 signal time
+    CHECK(s.HasSignalled());
+
+    virtual_now = 600;
+    CHECK(s.RunPending());
+    CHECK_EQ(runs_b, 1);
+    CHECK_EQ(s.GetTask(id).max_lateness_us, 500);
+    CHECK_EQ(s.GetTask(id).missed, 1);
+    CHECK(!s.HasSignalled());
+    CHECK(!s.RunPending());
+
+    // Invalid ids are ignored
+    s.Signal(-1);
+    s.Signal(7);
+    CHECK(!s.HasSignalled());
+}
+
+static void TestSignalFromTask()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    resignal_sched = &s;
+    resignal_runs = 0;
+    resignal_id = s.AddEvent(ResignalTask, 1000);
+
+    s.Signal(resignal_id);
+    while (s.RunPending()) {}
+    CHECK_EQ(resignal_runs, 3);
+    CHECK(!s.HasSignalled());
+}
+
+static void TestTimeUntilNext()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    CHECK_EQ(s.TimeUntilNext(), 0xFFFFFFFFu); // Nothing periodic
+
+    s.AddEvent(TaskB, 100);
+    CHECK_EQ(s.TimeUntilNext(), 0xFFFFFFFFu);
+
+    s.AddPeriodic(TaskA, 1000, 100);
+    s.AddPeriodic(TaskA, 3000, 100);
+    virtual_now = 300;
+    CHECK_EQ(s.TimeUntilNext(), 700);
+    virtual_now = 1200;
+    CHECK_EQ(s.TimeUntilNext(), 0); // Overdue
+}
+
+static void TestClockWrap()
+{
+    Reset(0xFFFFF000u);
+    Scheduler s;
+    s.Init(VirtualClock);
+    int id = s.AddPeriodic(TaskA, 1000, 100);
+    int ev = s.AddEvent(TaskB, 100);
+
+    // 4096 us before the wrap, 10 ms total: crosses zero
+    RunFor(s, 10000, 100);
+    CHECK_EQ(runs_a, 10);
+    CHECK_EQ(s.GetTask(id).max_lateness_us, 0);
+    CHECK_EQ(s.GetTask(id).missed, 0);
+    CHECK(virtual_now < 0x10000u);
+
+    // Signal just before the wrap, run just after
+    virtual_now = 0xFFFFFFC0u;
+    s.Signal(ev);
+    virtual_now = 0x20u;
+    s.RunPending();
+    CHECK_EQ(runs_b, 1);
+    CHECK_EQ(s.GetTask(ev).max_lateness_us, 0x60);
+}
+
+// Hardware-like counter: 3 ticks per us, wrapping at 1000003 ticks (~333 ms),
+// i.e. nowhere near 2^32 us
+static const uint32_t TICKS_PER_US = 3;
+static const uint32_t TICK_WRAP    = 1000003;
+static uint32_t virtual_ticks = 0;
+static TickClock tick_clock;
+static uint32_t TickClockUs() { return tick_clock.Update(virtual_ticks); }
+static uint32_t DividedTicksUs() { return virtual_ticks / TICKS_PER_US; } // What GetUs does
+
+static void AdvanceTicks(Scheduler& s, uint32_t duration_us, uint32_t step_us)
+{
+    for (uint32_t t = 0; t < duration_us; t += step_us) {
+        virtual_ticks = (virtual_ticks + step_us * TICKS_PER_US) % TICK_WRAP;
+        s.RunPending();
+    }
+}
+
+static void TestTickClockWrap()
+{
+    Reset(0);
+    virtual_ticks = TICK_WRAP - 5000;
+    tick_clock.Init(TICKS_PER_US, virtual_ticks, TICK_WRAP);
+    Scheduler s;
+    s.Init(TickClockUs);
+    int id = s.AddPeriodic(TaskA, 1000, 100);
+
+    // 2 s: six counter wraps, with steps that straddle them unevenly
+    AdvanceTicks(s, 2000000, 100);
+    CHECK_EQ(runs_a, 2000);
+    CHECK_EQ(s.GetTask(id).missed, 0);
+    CHECK_EQ(s.GetTask(id).max_lateness_us, 0);
+    CHECK_EQ(tick_clock.Update(virtual_ticks), 2000000);
+
+    // Sub-microsecond remainders are carried, not dropped
+    tick_clock.Init(TICKS_PER_US, 0, TICK_WRAP);
+    for (int i = 0; i < 30; i++) tick_clock.Update(i + 1);
+    CHECK_EQ(tick_clock.Update(30), 10);
+
+    // The divided-down counter jumps back at the wrap: a task due just
+    // before it is never reached again
+    Reset(0);
+    virtual_ticks = TICK_WRAP - 5000;
+    s.Init(DividedTicksUs);
+    s.AddPeriodic(TaskA, 1000, 100);
+    AdvanceTicks(s, 20000, 100);
+    CHECK(runs_a < 5);
+}
+
+static void TestTableLimits()
+{
+    Reset(0);
+    Scheduler s;
+    s.Init(VirtualClock);
+    CHECK_EQ(s.AddPeriodic(TaskA, 0, 100), -1);
+    for (int i = 0; i < Scheduler::MAX_TASKS; i++) CHECK_EQ(s.AddEvent(TaskB, 100), i);
+    CHECK_EQ(s.AddEvent(TaskB, 100), -1);
+    CHECK_EQ(s.GetTaskCount(), Scheduler::MAX_TASKS);
+}
+
+int main()
+{
+    TestPeriodicCadence();
+    TestOverrunSkipsBacklog();
+    TestRuntimeMeasured();
+    TestSignalCoalesces();
+    TestSignalFromTask();
+    TestTimeUntilNext();
+    TestClockWrap();
+    TestTickClockWrap();
+    TestTableLimits();
+    return TEST_RESULT("scheduler_test");
+}
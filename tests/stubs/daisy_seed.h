@@ -0,0 +1,4 @@
+#pragma once
+// Host stand-in for libDaisy: the engine code under test uses nothing from it.
+#include <cstddef>
+#include <cstdint>
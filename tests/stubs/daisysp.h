@@ -0,0 +1,162 @@
+#pragma once
+// Host stand-ins for the DaisySP pieces the engine uses. They follow the
+// DaisySP interfaces and algorithms closely enough for renders, but they are
+// not DaisySP: golden renders pin this repo's DSP (routing, filter, phaser,
+// reverb, event timing) on top of these fixed primitives.
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#define PI_F 3.1415927410125732421875f
+#define TWOPI_F (2.0f * PI_F)
+
+namespace daisysp {
+
+inline float fclamp(float in, float min, float max) { return fminf(fmaxf(in, min), max); }
+
+inline void fonepole(float& out, float in, float coeff) { out += coeff * (in - out); }
+
+class Oscillator {
+public:
+    enum { WAVE_SIN, WAVE_TRI, WAVE_SAW, WAVE_RAMP, WAVE_SQUARE, WAVE_LAST };
+
+    void Init(float sample_rate) {
+        sr_ = sample_rate; sr_recip_ = 1.0f / sample_rate;
+        freq_ = 100.0f; amp_ = 0.5f; pw_ = 0.5f; phase_ = 0.0f;
+        phase_inc_ = freq_ * sr_recip_; waveform_ = WAVE_SIN;
+    }
+    void SetFreq(float f) { freq_ = f; phase_inc_ = freq_ * sr_recip_; }
+    void SetAmp(float a) { amp_ = a; }
+    void SetWaveform(uint8_t wf) { waveform_ = wf < WAVE_LAST ? wf : (uint8_t)WAVE_SIN; }
+
+    float Process() {
+        float out;
+        switch (waveform_) {
+            case WAVE_SIN:    out = sinf(phase_ * TWOPI_F); break;
+            case WAVE_TRI:  { float t = -1.0f + (2.0f * phase_); out = 2.0f * (fabsf(t) - 0.5f); } break;
+            case WAVE_SAW:    out = -1.0f * ((phase_ * 2.0f) - 1.0f); break;
+            case WAVE_RAMP:   out = (phase_ * 2.0f) - 1.0f; break;
+            case WAVE_SQUARE: out = phase_ < pw_ ? 1.0f : -1.0f; break;
+            default:          out = 0.0f; break;
+        }
+        phase_ += phase_inc_;
+        if (phase_ > 1.0f) phase_ -= 1.0f;
+        return out * amp_;
+    }
+
+private:
+    float sr_, sr_recip_, freq_, amp_, pw_, phase_, phase_inc_;
+    uint8_t waveform_;
+};
+
+// Soft clipper with drive-dependent pre/post gain
+class Overdrive {
+public:
+    void Init() { SetDrive(0.5f); }
+    void SetDrive(float drive) {
+        drive_ = fclamp(drive, 0.0f, 1.0f);
+        pre_gain_ = 1.0f + drive_ * drive_ * 24.0f;
+        post_gain_ = 1.0f / tanhf(pre_gain_ * 0.5f + 0.5f);
+    }
+    float Process(float in) { return tanhf(in * pre_gain_) * post_gain_ * 0.8f; }
+
+private:
+    float drive_, pre_gain_, post_gain_;
+};
+
+template <typename T, size_t max_size>
+class DelayLine {
+public:
+    void Init() { Reset(); }
+    void Reset() {
+        for (size_t i = 0; i < max_size; i++) line_[i] = T(0);
+        write_ptr_ = 0;
+        delay_ = 1;
+    }
+    void SetDelay(size_t delay) { delay_ = delay < max_size ? delay : max_size - 1; }
+    void Write(const T sample) {
+        line_[write_ptr_] = sample;
+        write_ptr_ = (write_ptr_ - 1 + max_size) % max_size;
+    }
+    const T Read() const { return line_[(write_ptr_ + delay_) % max_size]; }
+    const T Allpass(const T sample, size_t delay, const T coefficient) {
+        T read = line_[(write_ptr_ + delay) % max_size];
+        T write = sample + coefficient * read;
+        Write(write);
+        return -write * coefficient + read;
+    }
+
+private:
+    size_t write_ptr_, delay_;
+    T line_[max_size];
+};
+
+// Model of DaisySP's Phaser, kept only as the A/B reference for the
+// StereoPhaser that replaced it (tests/phaser_ab.cpp). Each engine is a
+// modulated delay-line allpass whose delay tracks sr / (lfo + ap_freq + 30).
+class PhaserEngine {
+public:
+    void Init(float sample_rate) {
+        sr_ = sample_rate;
+        del_.Init();
+        feedback_ = 0.2f;
+        os_ = 30.0f;
+        deltime_ = 0.0f;
+        last_sample_ = 0.0f;
+        lfo_phase_ = 0.0f;
+        lfo_freq_ = 0.0f;
+        SetFreq(200.0f);
+        SetLfoFreq(0.3f);
+        SetLfoDepth(0.9f);
+    }
+    float Process(float in) {
+        float lfo_sig = ProcessLfo();
+        fonepole(deltime_, sr_ / (lfo_sig + ap_freq_ + os_), 0.0001f);
+        last_sample_ = del_.Allpass(in + feedback_ * last_sample_, (size_t)deltime_, 0.3f);
+        return (in + last_sample_) * 0.5f;
+    }
+    void SetLfoDepth(float depth) { lfo_amp_ = fclamp(depth, 0.0f, 1.0f); }
+    void SetLfoFreq(float lfo_freq) {
+        lfo_freq = 4.0f * lfo_freq / sr_;
+        lfo_freq *= lfo_freq_ < 0.0f ? -1.0f : 1.0f;
+        lfo_freq_ = fclamp(lfo_freq, -0.25f, 0.25f);
+    }
+    void SetFreq(float ap_freq) { ap_freq_ = fclamp(ap_freq, 0.0f, 20000.0f); }
+
+private:
+    float ProcessLfo() {
+        lfo_phase_ += lfo_freq_;
+        if (lfo_phase_ > 1.0f) { lfo_phase_ = 1.0f - (lfo_phase_ - 1.0f); lfo_freq_ *= -1.0f; }
+        else if (lfo_phase_ < -1.0f) { lfo_phase_ = -1.0f - (lfo_phase_ + 1.0f); lfo_freq_ *= -1.0f; }
+        return lfo_phase_ * lfo_amp_ * ap_freq_;
+    }
+
+    float sr_, ap_freq_, lfo_amp_, lfo_freq_, lfo_phase_, feedback_, os_, deltime_, last_sample_;
+    DelayLine<float, 2400> del_;
+};
+
+class Phaser {
+public:
+    static const int kMaxPoles = 8;
+
+    void Init(float sample_rate) {
+        for (int i = 0; i < kMaxPoles; i++) engines_[i].Init(sample_rate);
+        poles_ = 4;
+    }
+    float Process(float in) {
+        float sig = 0.0f;
+        for (int i = 0; i < poles_; i++) sig += engines_[i].Process(in);
+        return sig / poles_;
+    }
+    void SetPoles(int poles) { poles_ = poles < 1 ? 1 : (poles > kMaxPoles ? kMaxPoles : poles); }
+    void SetLfoDepth(float depth) { for (int i = 0; i < kMaxPoles; i++) engines_[i].SetLfoDepth(depth); }
+    void SetLfoFreq(float lfo_freq) { for (int i = 0; i < kMaxPoles; i++) engines_[i].SetLfoFreq(lfo_freq); }
+    void SetFreq(float ap_freq) { for (int i = 0; i < kMaxPoles; i++) engines_[i].SetFreq(ap_freq); }
+
+private:
+    PhaserEngine engines_[kMaxPoles];
+    int poles_;
+};
+
+} // namespace daisysp
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdio>
+
+// --- MINIMAL HOST TEST HELPERS ---
+// CHECK records a failure and keeps going; TEST_RESULT() is main's return.
+static int test_failures = 0;
+
+#define CHECK(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define CHECK_EQ(a, b) do { \
+    long long va_ = (long long)(a), vb_ = (long long)(b); \
+    if (va_ != vb_) { \
+        std::printf("FAIL %s:%d: %s == %s (%lld vs %lld)\n", __FILE__, __LINE__, #a, #b, va_, vb_); \
+        test_failures++; \
+    } \
+} while (0)
+
+#define TEST_RESULT(name) \
+    (std::printf("%s: %s\n", name, test_failures ? "FAILED" : "ok"), test_failures ? 1 : 0)